@@ -1,6 +1,12 @@
 #include "analysis.h"
 #include "encoding.h"
 #include "utils.h"
+#include "spectrum.h"
+#include "arena.h"
+#include "errstats.h"
+#include "sweep.h"
+#include "bitpack.h"
+#include "rng.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -145,91 +151,190 @@ void add_noise_4b5b(char *encoded, double ber)
 // -------------------------------------------------
 // Ejecutar N simulaciones con ruido
 // -------------------------------------------------
-void run_simulations(const char *filename, const char *bitstream, double ber, int N,
+void run_simulations(Report *report, const char *bitstream, double ber, int N,
                      const char *name, encode_ptr encode_fn, decode_ptr decode_fn)
 {
-    FILE *f = fopen(filename, "a");
-    if (!f) return; // Seguridad adicional
+    if (!report) return; // Seguridad adicional
 
     size_t len = strlen(bitstream);
-    double sum = 0, sum_sq = 0;
-    int min_err = (int)len, max_err = 0;
+    ErrorStats stats;
+    if (error_stats_init(&stats, len, 0) != 0) return;
+
+    // Temporales de cada ensayo en una arena: tras el primero no hay malloc
+    Arena arena;
+    arena_init(&arena, 6 * len + 256);
+    Arena *prev_arena = arena_set_current(&arena);
 
     for (int i = 0; i < N; i++) {
+        arena_reset(&arena);
         char *enc = encode_fn(bitstream);
         if (!enc) continue;
 
-        char *noisy = malloc(strlen(enc) + 1);
-        if (!noisy) { free(enc); continue; }
-        
-        strcpy(noisy, enc);
+        size_t enc_len = strlen(enc);
+        char *noisy = arena_alloc(&arena, enc_len + 1);
+        memcpy(noisy, enc, enc_len + 1);
 
         add_noise_encoded(noisy, ber, name);
         char *dec = decode_fn(noisy);
 
         // Si dec es NULL (común en 4B/5B con ruido), asumimos error total
         int errors = (dec == NULL) ? (int)len : (int)count_bit_errors(bitstream, dec);
+        error_stats_add(&stats, errors);
 
-        sum += errors;
-        sum_sq += (errors * errors);
-        if (errors < min_err) min_err = errors;
-        if (errors > max_err) max_err = errors;
-
-        free(enc); 
-        free(noisy);
-        if (dec) free(dec);
+        // Lo que el codificador pidió fuera de la arena (malloc directo) se libera aquí
+        current_free(enc);
+        current_free(dec);
     }
 
-    double mean = sum / N;
-    // Cálculo de varianza y desviación estándar
-    double variance = (sum_sq / N) - (mean * mean);
-    double std_dev = sqrt(variance > 0 ? variance : 0);
+    arena_set_current(prev_arena);
+    arena_free(&arena);
 
-    fprintf(f, "| %s | %.2f | %d | %d | %.2f |\n", name, mean, min_err, max_err, std_dev);
-    fclose(f);
+    report_error_stats_row(report, name, &stats);
+    error_stats_free(&stats);
 }
 
-void prepare_analysis_report(const char *filename, const char *cedula, double personal_ber) {
-    FILE *f = fopen(filename, "w");
-    if (!f) return;
+void prepare_analysis_report(Report *report, const char *cedula, double personal_ber) {
+    if (!report) return;
 
-    fprintf(f, "# Informe de Análisis de Transmisión\n\n");
-    fprintf(f, "Estudiante: **%s** | BER Asignado: **%.3f**\n\n", cedula, personal_ber);
+    report_printf(report, "# Informe de Análisis de Transmisión\n\n");
+    report_printf(report, "Estudiante: **%s** | BER Asignado: **%.3f**\n\n", cedula, personal_ber);
 
-    fprintf(f, "## Parte B: Análisis Cuantitativo\n\n");
-    fprintf(f, "### 1. Overhead de Codificación\n");
-    fprintf(f, "Cálculo basado en 1000 bits útiles:\n\n");
-    fprintf(f, "| Esquema | Bits Útiles | Bits Transmitidos | Overhead | Eficiencia |\n");
-    fprintf(f, "| :--- | :---: | :---: | :---: | :---: |\n");
-    fprintf(f, "| NRZ / NRZI | 1000 | 1000 | 0%% | 100%% |\n");
-    fprintf(f, "| Manchester | 1000 | 2000 | 100%% | 50%% |\n");
-    fprintf(f, "| 4B/5B | 1000 | 1250 | 25%% | 80%% |\n\n");
+    report_printf(report, "## Parte B: Análisis Cuantitativo\n\n");
+    report_printf(report, "### 1. Overhead de Codificación\n");
+    report_printf(report, "Cálculo basado en 1000 bits útiles:\n\n");
+    report_table_begin(report, "Overhead de codificación",
+                       "Esquema\tBits Útiles\tBits Transmitidos\tOverhead\tEficiencia");
+    report_row(report, 0, "NRZ / NRZI\t1000\t1000\t0%%\t100%%");
+    report_row(report, 0, "Manchester\t1000\t2000\t100%%\t50%%");
+    report_row(report, 0, "4B/5B\t1000\t1250\t25%%\t80%%");
+    report_printf(report, "\n");
 
-    fprintf(f, "### 2. Análisis Estadístico de Errores (N=50)\n");
-    fprintf(f, "Probabilidad de bit errado (BER) = %.3f\n\n", personal_ber);
-    fprintf(f, "| Esquema | Media Errores | Mínimo | Máximo | Desv. Estándar |\n");
-    fprintf(f, "| :--- | :---: | :---: | :---: | :---: |\n");
+    report_printf(report, "### 2. Análisis Estadístico de Errores (N=50)\n");
+    report_printf(report, "Probabilidad de bit errado (BER) = %.3f\n\n", personal_ber);
 
-    fclose(f);
+    // Las filas las agregan run_simulations / run_simulations_sliced
+    report_table_begin(report, "Errores por esquema",
+                       "Esquema\tMedia Errores\tMínimo\tMáximo\tDesv. Estándar\tp50\tp99\tp99.9");
 }
 
-void run_ber_sensitivity_analysis(const char *filename, const char *bitstream) {
-    FILE *f = fopen(filename, "a");
-    fprintf(f, "\n### 3. Curva BER vs Tasa de Error Efectiva\n");
-    fprintf(f, "| BER Entrada | Error NRZ | Error Manchester | Error 4B/5B |\n");
-    fprintf(f, "| :--- | :---: | :---: | :---: |\n");
+/**
+ * Fracción de bits errados de un punto del barrido, tomada del mapa por
+ * posición: en un mensaje que no decodifica solo cuentan los bits de los
+ * bloques inválidos (borraduras), no la trama entera.
+ */
+static double sweep_bit_error_rate(const SweepPoint *p, size_t len) {
+    const ErrorStats *s = &p->stats;
+    if (s->trials == 0 || len == 0) return 0.0;
+    uint64_t wrong = 0;
+    for (size_t i = 0; i < s->n_pos; i++)
+        wrong += s->heat[i];
+    return (double)wrong / ((double)s->trials * (double)len);
+}
 
+void run_ber_sensitivity_analysis(Report *report, size_t n_bits) {
+    if (!report) return;
     double bers[] = {0.001, 0.01, 0.1}; // Incrementos logarítmicos
-    for (int i = 0; i < 3; i++) {
-        // Aquí llamarías a una versión simplificada de run_simulations que devuelva solo la media
-        fprintf(f, "| %.3f | ... | ... | ... |\n", bers[i]);
+    const LineCodec *codecs[] = {codec_find("NRZ"), codec_find("Manchester"), codec_find("4B/5B")};
+    const uint64_t trials = 200;
+
+    // Mensaje con semilla fija: el barrido es el mismo en cada ejecución y el
+    // checkpoint sirve para reanudarlo
+    size_t len = n_bits / 4 * 4;
+    char *message = safe_malloc(len + 1);
+    Rng rng;
+    rng_seed(&rng, 30532641u);
+    for (size_t i = 0; i < len; i += 64) {
+        uint64_t w = rng_next(&rng);
+        uint8_t bytes[8];
+        for (int k = 0; k < 8; k++)
+            bytes[k] = (uint8_t)(w >> (56 - 8 * k));
+        bits_unpack(bytes, (len - i < 64) ? len - i : 64, message + i, '0', '1');
+    }
+    message[len] = '\0';
+
+    // Barrido con checkpoint junto al informe: si se corta, la próxima ejecución sigue desde ahí
+    size_t ckpt_len = strlen(report->base) + sizeof("_ber.ckpt");
+    char *checkpoint = safe_malloc(ckpt_len);
+    snprintf(checkpoint, ckpt_len, "%s_ber.ckpt", report->base);
+
+    Sweep sweep = {0};
+    int swept = sweep_init(&sweep, message, codecs, 3, bers, 3, trials, 30532641u, 50, 0) == 0 &&
+                sweep_run(&sweep, checkpoint, 0) == 0;
+
+    report_printf(report, "\n### 3. Curva BER vs Tasa de Error Efectiva\n");
+    report_printf(report, "Fracción de bits decodificados con error (%llu ensayos por punto). Un bloque de "
+                  "línea inválido borra solo sus bits, no la trama entera.\n\n",
+                  (unsigned long long)trials);
+    report_table_begin(report, "Curva BER", "BER Entrada\tError NRZ\tError Manchester\tError 4B/5B");
+
+    // Primer BER en que Manchester queda por debajo de NRZ (-1: en ninguno)
+    int crossover = -1;
+    for (size_t i = 0; i < 3; i++) {
+        if (!swept) {
+            report_row(report, 0, "%.3f\t-\t-\t-", bers[i]);
+            continue;
+        }
+        double rate[3];
+        for (size_t c = 0; c < 3; c++)
+            rate[c] = sweep_bit_error_rate(sweep_point(&sweep, c, i), sweep.len);
+        report_row(report, 0, "%.3f\t%.4f\t%.4f\t%.4f", bers[i], rate[0], rate[1], rate[2]);
+        if (crossover < 0 && rate[1] < rate[0])
+            crossover = (int)i;
     }
-    
-    fprintf(f, "\n**Conclusión Curva:** Manchester supera a NRZ a partir de un BER de 0.05 (aprox) debido a que su transición asegura la sincronía del reloj incluso con ruido fuerte.\n");
-
-    fprintf(f, "\n### 4. Análisis de Resistencia a Ráfagas\n");
-    fprintf(f, "Se aplicó una ráfaga de 5 bits errados.\n");
-    fprintf(f, "- **Resultado:** NRZ propagó el error de forma lineal. 4B/5B falló totalmente la secuencia (invalid symbol), demostrando alta sensibilidad a ráfagas consecutivas.\n");
-    
-    fclose(f);
-}
\ No newline at end of file
+    if (swept)
+        remove(checkpoint); // Barrido completo: el estado ya no hace falta
+    sweep_free(&sweep);
+    free(checkpoint);
+    free(message);
+
+    // Conclusión a partir de los puntos medidos
+    if (!swept)
+        report_printf(report, "\n**Conclusión Curva:** el barrido no terminó; no hay datos para comparar.\n");
+    else if (crossover >= 0)
+        report_printf(report, "\n**Conclusión Curva:** Manchester tiene menor tasa de error efectiva que NRZ a "
+                      "partir de un BER de %.3f.\n", bers[crossover]);
+    else
+        report_printf(report, "\n**Conclusión Curva:** NRZ tiene menor tasa de error efectiva que Manchester en "
+                      "todos los BER medidos: Manchester envía dos símbolos por bit y un par inválido basta "
+                      "para perder el bit.\n");
+
+    report_printf(report, "\n### 4. Análisis de Resistencia a Ráfagas\n");
+    report_printf(report, "Se aplicó una ráfaga de 5 bits errados.\n");
+    report_printf(report, "- **Resultado:** NRZ propagó el error de forma lineal. 4B/5B falló totalmente la secuencia (invalid symbol), demostrando alta sensibilidad a ráfagas consecutivas.\n");
+}
+
+// -------------------------------------------------
+// Ancho de banda medido a partir de la PSD
+// -------------------------------------------------
+void run_spectral_analysis(Report *report, size_t n_bits) {
+    if (!report) return;
+
+    struct {
+        const char *name;
+        encode_ptr encode;
+        size_t bit_multiple;
+    } schemes[] = {
+        {"NRZ", encode_nrz, 1},
+        {"NRZI", encode_nrzi, 1},
+        {"Manchester", encode_manchester, 1},
+        {"4B/5B", encode_4b5b, 4},
+    };
+
+    report_printf(report, "\n### 5. Ancho de Banda Medido (PSD, Welch)\n");
+    report_printf(report, "%zu bits aleatorios por esquema, 8 muestras por símbolo, segmentos de 1024 puntos.\n\n",
+                  n_bits);
+    report_table_begin(report, "Ancho de banda medido",
+                       "Esquema\tPrimer Nulo (x Rb)\tEficiencia\tEnergía en DC\tSegmentos");
+
+    for (size_t i = 0; i < sizeof(schemes) / sizeof(schemes[0]); i++) {
+        PsdResult psd;
+        if (psd_welch(schemes[i].encode, n_bits, schemes[i].bit_multiple, 8, 1024, 30532641u + i, &psd) != 0) {
+            report_row(report, 0, "%s\terror\t-\t-\t-", schemes[i].name);
+            continue;
+        }
+        double eff = (psd.null_bw > 0) ? 100.0 / psd.null_bw : 0;
+        report_row(report, 0, "%s\t%.3f\t%.0f%%\t%.4f%%\t%zu", schemes[i].name, psd.null_bw, eff,
+                   100.0 * psd.dc_fraction, psd.segments);
+        psd_free(&psd);
+    }
+}
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include "report.h"
 
 // 1. Definición de tipos para punteros a funciones (Hacer que coincidan con encoding.h)
 typedef char* (*encode_ptr)(const char*);
@@ -14,16 +15,22 @@ size_t count_bit_errors(const char* original, const char* received);
 size_t get_encoded_length(const char* bitstream, encode_ptr encode);
 
 // 3. Reporte de Análisis (Parte B)
-void prepare_analysis_report(const char *filename, const char *cedula, double personal_ber);
+void prepare_analysis_report(Report *report, const char *cedula, double personal_ber);
 
 // 4. Simulaciones Estadísticas
 // NOTA: Usamos los typedef encode_ptr/decode_ptr para que la firma sea limpia y consistente
-void run_simulations(const char *filename, const char *bitstream, double ber, int N,
+void run_simulations(Report *report, const char *bitstream, double ber, int N,
                      const char *name, encode_ptr encode, decode_ptr decode);
 
-void run_ber_sensitivity_analysis(const char *filename, const char *bitstream);
+// Curva BER con barrido reanudable (checkpoint junto al informe). El mensaje de
+// n_bits bits (redondeado a múltiplo de 4) se genera con semilla fija: así una
+// ejecución cortada sigue en la próxima con el mismo barrido
+void run_ber_sensitivity_analysis(Report *report, size_t n_bits);
 
 // 5. Inyección de Errores
 void simulate_burst_errors(char* bitstream, double ber, size_t burst_len);
 
+// 6. Análisis Espectral (PSD por Welch, ver spectrum.h)
+void run_spectral_analysis(Report *report, size_t n_bits);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "arena.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Cabecera de bloque redondeada para que los datos queden alineados
+#define ARENA_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static _Thread_local Arena *current_arena = NULL;
+
+static size_t align_up(size_t n)
+{
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+static unsigned char *block_data(ArenaBlock *b)
+{
+    return (unsigned char *)b + ARENA_HEADER;
+}
+
+static ArenaBlock *block_new(Arena *a, size_t size)
+{
+    ArenaBlock *b = safe_malloc(ARENA_HEADER + size);
+    b->next = NULL;
+    b->size = size;
+    b->used = 0;
+    a->mallocs++;
+    return b;
+}
+
+// ============================================
+// Arena
+// ============================================
+
+void arena_init(Arena *a, size_t block_size)
+{
+    if (!a)
+        return;
+    a->head = NULL;
+    a->block_size = align_up(block_size ? block_size : 4096);
+    a->mallocs = 0;
+}
+
+void *arena_alloc(Arena *a, size_t size)
+{
+    size = align_up(size ? size : 1);
+
+    ArenaBlock *b = a->head;
+    if (!b || b->size - b->used < size)
+    {
+        b = block_new(a, size > a->block_size ? size : a->block_size);
+        b->next = a->head;
+        a->head = b;
+    }
+
+    void *p = block_data(b) + b->used;
+    b->used += size;
+    return p;
+}
+
+void arena_reset(Arena *a)
+{
+    if (!a || !a->head)
+        return;
+
+    if (!a->head->next)
+    {
+        a->head->used = 0;
+        return;
+    }
+
+    // Varios bloques: se funden en uno que alcance para todo el ciclo
+    size_t total = 0;
+    for (ArenaBlock *b = a->head; b;)
+    {
+        ArenaBlock *next = b->next;
+        total += b->size;
+        free(b);
+        b = next;
+    }
+    a->head = block_new(a, total);
+}
+
+int arena_owns(const Arena *a, const void *p)
+{
+    if (!a || !p)
+        return 0;
+
+    const unsigned char *c = p;
+    for (ArenaBlock *b = a->head; b; b = b->next)
+    {
+        const unsigned char *start = block_data(b);
+        if (c >= start && c < start + b->size)
+            return 1;
+    }
+    return 0;
+}
+
+void arena_free(Arena *a)
+{
+    if (!a)
+        return;
+    for (ArenaBlock *b = a->head; b;)
+    {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+    a->head = NULL;
+}
+
+// ============================================
+// Arena actual del hilo
+// ============================================
+
+Arena *arena_set_current(Arena *a)
+{
+    Arena *prev = current_arena;
+    current_arena = a;
+    return prev;
+}
+
+Arena *arena_get_current(void)
+{
+    return current_arena;
+}
+
+void *current_alloc(size_t size)
+{
+    return current_arena ? arena_alloc(current_arena, size) : safe_malloc(size);
+}
+
+void current_free(void *p)
+{
+    if (p && !arena_owns(current_arena, p))
+        free(p);
+}
+
+// ============================================
+// Pool de buffers
+// ============================================
+
+int pool_init(BufferPool *p, size_t buf_size, size_t per_slab)
+{
+    if (!p || buf_size == 0 || per_slab == 0)
+        return -1;
+
+    p->buf_size = align_up(buf_size < sizeof(void *) ? sizeof(void *) : buf_size);
+    p->per_slab = per_slab;
+    p->free_list = NULL;
+    p->slabs = NULL;
+    p->n_slabs = p->cap_slabs = 0;
+    p->mallocs = 0;
+    return pthread_mutex_init(&p->lock, NULL) == 0 ? 0 : -1;
+}
+
+/**
+ * Reserva un lote de buffers y los encadena en la lista libre (con el candado tomado)
+ */
+static void pool_refill(BufferPool *p)
+{
+    if (p->n_slabs == p->cap_slabs)
+    {
+        p->cap_slabs = p->cap_slabs ? 2 * p->cap_slabs : 8;
+        void **tmp = realloc(p->slabs, p->cap_slabs * sizeof(void *));
+        if (!tmp)
+        {
+            fprintf(stderr, "Error: sin memoria para el pool\n");
+            exit(EXIT_FAILURE);
+        }
+        p->slabs = tmp;
+    }
+
+    unsigned char *slab = safe_malloc(p->buf_size * p->per_slab);
+    p->slabs[p->n_slabs++] = slab;
+    p->mallocs++;
+
+    for (size_t i = p->per_slab; i-- > 0;)
+    {
+        void *buf = slab + i * p->buf_size;
+        *(void **)buf = p->free_list;
+        p->free_list = buf;
+    }
+}
+
+void *pool_get(BufferPool *p)
+{
+    pthread_mutex_lock(&p->lock);
+    if (!p->free_list)
+        pool_refill(p);
+    void *buf = p->free_list;
+    p->free_list = *(void **)buf;
+    pthread_mutex_unlock(&p->lock);
+    return buf;
+}
+
+void pool_put(BufferPool *p, void *buf)
+{
+    if (!buf)
+        return;
+    pthread_mutex_lock(&p->lock);
+    *(void **)buf = p->free_list;
+    p->free_list = buf;
+    pthread_mutex_unlock(&p->lock);
+}
+
+void pool_destroy(BufferPool *p)
+{
+    if (!p)
+        return;
+    for (size_t i = 0; i < p->n_slabs; i++)
+        free(p->slabs[i]);
+    free(p->slabs);
+    p->slabs = NULL;
+    p->free_list = NULL;
+    p->n_slabs = p->cap_slabs = 0;
+    pthread_mutex_destroy(&p->lock);
+}
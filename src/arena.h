@@ -0,0 +1,128 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+/**
+ * @file arena.h
+ * @brief Memoria temporal sin malloc en régimen estable
+ *
+ * - Arena: reserva por incremento de puntero y se vacía entera con
+ *   arena_reset (por ensayo o por trozo). Si un ciclo necesitó varios
+ *   bloques, el reset los funde en uno solo del tamaño total, así que a
+ *   partir del segundo ciclo no se vuelve a llamar a malloc.
+ * - Arena actual por hilo: los codificadores de encoding.h reservan su
+ *   resultado con current_alloc, que usa la arena actual del hilo si hay
+ *   una (o safe_malloc si no). current_free libera con free solo lo que no
+ *   pertenece a la arena, así que sirve en ambos casos.
+ * - BufferPool: buffers de tamaño fijo reciclados por lista libre, con
+ *   candado, para pasar trozos entre hilos.
+ */
+
+#include <stddef.h>
+#include <pthread.h>
+
+// Alineación de todas las reservas
+#define ARENA_ALIGN 16
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t size;  // Bytes utilizables
+    size_t used;
+} ArenaBlock;
+
+typedef struct
+{
+    ArenaBlock *head;   // Bloque activo (los siguientes ya están llenos)
+    size_t block_size;  // Tamaño mínimo de un bloque nuevo
+    size_t mallocs;     // Bloques pedidos al sistema (para verificar el régimen estable)
+} Arena;
+
+/**
+ * @brief Inicializa una arena vacía (no reserva hasta el primer uso)
+ * @param a Arena
+ * @param block_size Tamaño mínimo de cada bloque
+ */
+void arena_init(Arena *a, size_t block_size);
+
+/**
+ * @brief Reserva `size` bytes alineados a ARENA_ALIGN (nunca devuelve NULL)
+ */
+void *arena_alloc(Arena *a, size_t size);
+
+/**
+ * @brief Descarta todas las reservas conservando la memoria
+ */
+void arena_reset(Arena *a);
+
+/**
+ * @brief Indica si `p` fue reservado en la arena
+ */
+int arena_owns(const Arena *a, const void *p);
+
+/**
+ * @brief Devuelve toda la memoria al sistema
+ */
+void arena_free(Arena *a);
+
+/**
+ * @brief Cambia la arena actual del hilo
+ * @param a Nueva arena (NULL para volver a malloc)
+ * @return Arena actual anterior (para restaurarla)
+ */
+Arena *arena_set_current(Arena *a);
+
+/**
+ * @brief Arena actual del hilo, o NULL
+ */
+Arena *arena_get_current(void);
+
+/**
+ * @brief Reserva en la arena actual del hilo, o con safe_malloc si no hay
+ */
+void *current_alloc(size_t size);
+
+/**
+ * @brief Libera memoria de current_alloc (no hace nada si es de la arena actual)
+ */
+void current_free(void *p);
+
+// ============================================
+// Pool de buffers de tamaño fijo
+// ============================================
+
+typedef struct
+{
+    size_t buf_size;     // Tamaño de cada buffer (redondeado a ARENA_ALIGN)
+    size_t per_slab;     // Buffers por cada reserva al sistema
+    void *free_list;     // Buffers libres (el primer puntero de cada uno enlaza al siguiente)
+    void **slabs;        // Reservas hechas, para liberarlas al final
+    size_t n_slabs, cap_slabs;
+    size_t mallocs;
+    pthread_mutex_t lock;
+} BufferPool;
+
+/**
+ * @brief Inicializa un pool
+ * @param p Pool
+ * @param buf_size Bytes por buffer
+ * @param per_slab Buffers que se reservan juntos cuando la lista libre se vacía
+ * @return 0 si tuvo éxito, -1 si los parámetros no son válidos
+ */
+int pool_init(BufferPool *p, size_t buf_size, size_t per_slab);
+
+/**
+ * @brief Toma un buffer (reserva un nuevo lote solo si no queda ninguno libre)
+ */
+void *pool_get(BufferPool *p);
+
+/**
+ * @brief Devuelve un buffer al pool
+ */
+void pool_put(BufferPool *p, void *buf);
+
+/**
+ * @brief Libera toda la memoria del pool (los buffers dejan de ser válidos)
+ */
+void pool_destroy(BufferPool *p);
+
+#endif // ARENA_H
@@ -0,0 +1,163 @@
+#define _POSIX_C_SOURCE 200809L
+#include "batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct
+{
+    line_block_fn fn;
+    unsigned in_block;
+    const BitMessage *msgs;
+    char *arena;
+    const size_t *offsets;
+    int *status;
+    size_t begin, end;
+    long failed;
+    int threaded; // 1 si se lanzó un hilo para este rango
+} BatchRange;
+
+/**
+ * Longitud de salida de un mensaje, o 0 si su longitud no es múltiplo
+ * del bloque de entrada (en cuyo caso el mensaje se marca inválido).
+ */
+static size_t frame_output_len(size_t len, unsigned in_block, unsigned out_block)
+{
+    return (len % in_block == 0) ? len / in_block * out_block : 0;
+}
+
+static void *batch_worker(void *arg)
+{
+    BatchRange *r = arg;
+    LineState st;
+
+    for (size_t i = r->begin; i < r->end; i++)
+    {
+        const BitMessage *m = &r->msgs[i];
+        int ok = (m->len % r->in_block == 0);
+
+        if (ok)
+        {
+            line_state_init(&st); // Cada trama empieza en el nivel acordado
+            ok = (r->fn(m->data, m->len, r->arena + r->offsets[i], &st) == 0);
+        }
+
+        if (r->status)
+            r->status[i] = ok ? 0 : -1;
+        if (!ok)
+            r->failed++;
+    }
+    return NULL;
+}
+
+size_t batch_output_size(const LineCodec *codec, const BitMessage *msgs, size_t count, int decode)
+{
+    if (!codec || !msgs)
+        return 0;
+
+    unsigned in_block = decode ? codec->out_block : codec->in_block;
+    unsigned out_block = decode ? codec->in_block : codec->out_block;
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; i++)
+        total += frame_output_len(msgs[i].len, in_block, out_block);
+    return total;
+}
+
+static long batch_run(const LineCodec *codec, const BitMessage *msgs, size_t count, char *arena,
+                      size_t arena_size, size_t *offsets, int *status, unsigned nthreads, int decode)
+{
+    if (!codec || !msgs || !offsets || (!arena && arena_size > 0))
+        return -1;
+
+    unsigned in_block = decode ? codec->out_block : codec->in_block;
+    unsigned out_block = decode ? codec->in_block : codec->out_block;
+
+    // Primera pasada: posiciones de salida (prefix sum de las longitudes)
+    size_t total = 0, in_bytes = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        offsets[i] = total;
+        total += frame_output_len(msgs[i].len, in_block, out_block);
+        in_bytes += msgs[i].len;
+    }
+    offsets[count] = total;
+
+    if (total > arena_size)
+    {
+        fprintf(stderr, "Error: arena de %zu bytes insuficiente (se necesitan %zu)\n", arena_size, total);
+        return -1;
+    }
+
+    if (nthreads == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (online > 0) ? (unsigned)online : 1;
+    }
+    if (in_bytes < BATCH_PARALLEL_MIN_BYTES || count < 2)
+        nthreads = 1;
+    if (nthreads > count)
+        nthreads = (unsigned)count;
+
+    BatchRange single = {decode ? codec->decode_block : codec->encode_block, in_block, msgs, arena,
+                         offsets, status, 0, count, 0, 0};
+    if (nthreads <= 1)
+    {
+        batch_worker(&single);
+        return single.failed;
+    }
+
+    BatchRange *ranges = malloc(nthreads * sizeof(BatchRange));
+    pthread_t *tids = malloc(nthreads * sizeof(pthread_t));
+    if (!ranges || !tids)
+    {
+        free(ranges);
+        free(tids);
+        batch_worker(&single);
+        return single.failed;
+    }
+
+    // Reparto por volumen de entrada para equilibrar tramas de distinto tamaño
+    size_t per_thread = in_bytes / nthreads + 1;
+    size_t begin = 0;
+    unsigned used = 0;
+    for (unsigned t = 0; t < nthreads && begin < count; t++, used++)
+    {
+        size_t end = begin, acc = 0;
+        while (end < count && (acc < per_thread || t == nthreads - 1))
+            acc += msgs[end++].len;
+
+        ranges[t] = single;
+        ranges[t].begin = begin;
+        ranges[t].end = end;
+        ranges[t].threaded = (pthread_create(&tids[t], NULL, batch_worker, &ranges[t]) == 0);
+        if (!ranges[t].threaded)
+            batch_worker(&ranges[t]); // Sin hilo disponible: se procesa aquí
+        begin = end;
+    }
+
+    long failed = 0;
+    for (unsigned t = 0; t < used; t++)
+    {
+        if (ranges[t].threaded)
+            pthread_join(tids[t], NULL);
+        failed += ranges[t].failed;
+    }
+
+    free(ranges);
+    free(tids);
+    return failed;
+}
+
+long batch_encode(const LineCodec *codec, const BitMessage *msgs, size_t count,
+                  char *arena, size_t arena_size, size_t *offsets, int *status, unsigned nthreads)
+{
+    return batch_run(codec, msgs, count, arena, arena_size, offsets, status, nthreads, 0);
+}
+
+long batch_decode(const LineCodec *codec, const BitMessage *msgs, size_t count,
+                  char *arena, size_t arena_size, size_t *offsets, int *status, unsigned nthreads)
+{
+    return batch_run(codec, msgs, count, arena, arena_size, offsets, status, nthreads, 1);
+}
@@ -0,0 +1,56 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+/**
+ * @file batch.h
+ * @brief Codificación/decodificación de muchos mensajes cortos por llamada
+ *
+ * Los mensajes se describen como pares (puntero, longitud), sin '\0' ni
+ * strlen. Toda la salida va a un único buffer contiguo (arena) del llamador
+ * y offsets[i] .. offsets[i+1] delimita la salida del mensaje i.
+ */
+
+#include <stddef.h>
+#include "codec.h"
+
+typedef struct
+{
+    const char *data;
+    size_t len;
+} BitMessage;
+
+// Por debajo de este volumen de entrada (bytes) el lote se procesa en un hilo
+#define BATCH_PARALLEL_MIN_BYTES (1u << 20)
+
+/**
+ * @brief Tamaño de arena necesario para un lote
+ * @param codec Esquema a usar
+ * @param msgs Mensajes del lote
+ * @param count Número de mensajes
+ * @param decode 0 para codificar, 1 para decodificar
+ * @return Bytes necesarios en la arena
+ */
+size_t batch_output_size(const LineCodec *codec, const BitMessage *msgs, size_t count, int decode);
+
+/**
+ * @brief Codifica un lote de mensajes
+ * @param codec Esquema a usar
+ * @param msgs Mensajes del lote
+ * @param count Número de mensajes
+ * @param arena Buffer de salida contiguo
+ * @param arena_size Tamaño de la arena (ver batch_output_size)
+ * @param offsets Salida: count + 1 posiciones dentro de la arena
+ * @param status Salida opcional (puede ser NULL): 0 o -1 por mensaje
+ * @param nthreads Hilos a usar (0 = automático, 1 = secuencial)
+ * @return Número de mensajes inválidos, o -1 si los argumentos no son válidos
+ */
+long batch_encode(const LineCodec *codec, const BitMessage *msgs, size_t count,
+                  char *arena, size_t arena_size, size_t *offsets, int *status, unsigned nthreads);
+
+/**
+ * @brief Decodifica un lote de señales (mismos parámetros que batch_encode)
+ */
+long batch_decode(const LineCodec *codec, const BitMessage *msgs, size_t count,
+                  char *arena, size_t arena_size, size_t *offsets, int *status, unsigned nthreads);
+
+#endif // BATCH_H
@@ -0,0 +1,315 @@
+#include "bitpack.h"
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define BITPACK_HAVE_X86 1
+#endif
+
+#define ONES8 0x0101010101010101ULL
+
+// Junta el bit 0 de cada byte en un byte (byte 0 → bit 7) y su inversa
+#define GATHER_MAGIC 0x8040201008040201ULL
+
+enum
+{
+    KERNEL_SWAR,
+    KERNEL_SSE2,
+    KERNEL_AVX2
+};
+
+static int kernel = KERNEL_SWAR;
+static pthread_once_t kernel_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Mejor ruta que admite la CPU
+ */
+static int kernel_best(void)
+{
+#ifdef BITPACK_HAVE_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? KERNEL_AVX2 : KERNEL_SSE2;
+#else
+    return KERNEL_SWAR;
+#endif
+}
+
+static void kernel_init(void)
+{
+    kernel = kernel_best();
+}
+
+/**
+ * Posición (0-7) del único bit en que difieren los dos símbolos, o -1
+ */
+static int diff_shift(char zero, char one)
+{
+    unsigned d = (unsigned char)zero ^ (unsigned char)one;
+    if (d == 0 || (d & (d - 1)) != 0)
+        return -1;
+    return __builtin_ctz(d);
+}
+
+// ============================================
+// SWAR (64 bits, 8 símbolos por palabra)
+// ============================================
+
+static size_t validate_swar(const char *in, size_t n, char zero, char one, size_t i)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    int shift = diff_shift(zero, one);
+    if (shift >= 0)
+    {
+        uint64_t base = ONES8 * (unsigned char)zero;
+        uint64_t keep = ~(ONES8 << shift);
+        for (; i + 8 <= n; i += 8)
+        {
+            uint64_t x;
+            memcpy(&x, in + i, 8);
+            if (((x ^ base) & keep) != 0)
+                break;
+        }
+    }
+#endif
+    for (; i < n; i++)
+        if (in[i] != zero && in[i] != one)
+            return i;
+    return n;
+}
+
+static int pack_swar(const char *in, size_t n, uint8_t *out, char zero, char one, size_t i)
+{
+    int bad = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    int shift = diff_shift(zero, one);
+    if (shift >= 0)
+    {
+        uint64_t base = ONES8 * (unsigned char)zero;
+        uint64_t keep = ~(ONES8 << shift);
+        for (; i + 8 <= n; i += 8)
+        {
+            uint64_t x;
+            memcpy(&x, in + i, 8);
+            uint64_t d = x ^ base;
+            bad |= (d & keep) != 0;
+            // Con un símbolo inválido el bit se calcula igual que en la ruta escalar
+            uint64_t ones = ~(x ^ (ONES8 * (unsigned char)one));
+            ones &= ones >> 4;
+            ones &= ones >> 2;
+            ones &= ones >> 1;
+            out[i / 8] = (uint8_t)(((ones & ONES8) * GATHER_MAGIC) >> 56);
+        }
+    }
+#endif
+    // Resto (y alfabetos que difieren en más de un bit)
+    for (; i < n; i += 8)
+    {
+        uint8_t byte = 0;
+        for (size_t k = 0; k < 8 && i + k < n; k++)
+        {
+            char c = in[i + k];
+            bad |= (c != zero && c != one);
+            byte |= (uint8_t)((c == one) << (7 - k));
+        }
+        out[i / 8] = byte;
+    }
+    return bad ? -1 : 0;
+}
+
+static void unpack_swar(const uint8_t *in, size_t n, char *out, char zero, char one, size_t i)
+{
+    uint64_t base = ONES8 * (unsigned char)zero;
+    uint64_t flip = (unsigned char)zero ^ (unsigned char)one;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t spread = ((in[i / 8] * GATHER_MAGIC) >> 7) & ONES8;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        uint64_t x = base ^ (spread * flip); // Cada byte queda en zero o one
+        memcpy(out + i, &x, 8);
+#else
+        for (int k = 0; k < 8; k++)
+            out[i + k] = ((spread >> (8 * k)) & 1) ? one : zero;
+#endif
+    }
+    for (; i < n; i++)
+        out[i] = ((in[i / 8] >> (7 - i % 8)) & 1) ? one : zero;
+}
+
+// ============================================
+// SSE2 (16 símbolos)
+// ============================================
+
+#ifdef BITPACK_HAVE_X86
+
+// Inversión de bits de un byte
+#define R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define R4(n) R2(n), R2(n + 2 * 16), R2(n + 1 * 16), R2(n + 3 * 16)
+#define R6(n) R4(n), R4(n + 2 * 4), R4(n + 1 * 4), R4(n + 3 * 4)
+static const uint8_t REV8[256] = {R6(0), R6(2), R6(1), R6(3)};
+
+static size_t validate_sse2(const char *in, size_t n, char zero, char one)
+{
+    __m128i z = _mm_set1_epi8(zero), o = _mm_set1_epi8(one);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        unsigned ok = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, z), _mm_cmpeq_epi8(v, o)));
+        if (ok != 0xFFFF)
+            return i + (size_t)__builtin_ctz(~ok);
+    }
+    return validate_swar(in, n, zero, one, i);
+}
+
+static int pack_sse2(const char *in, size_t n, uint8_t *out, char zero, char one)
+{
+    __m128i z = _mm_set1_epi8(zero), o = _mm_set1_epi8(one);
+    unsigned bad = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i is_one = _mm_cmpeq_epi8(v, o);
+        unsigned ok = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, z), is_one));
+        unsigned bits = (unsigned)_mm_movemask_epi8(is_one); // Bit k = símbolo k
+        bad |= ok ^ 0xFFFF;
+        out[i / 8] = REV8[bits & 0xFF];
+        out[i / 8 + 1] = REV8[bits >> 8];
+    }
+    int tail = pack_swar(in, n, out, zero, one, i);
+    return (bad || tail) ? -1 : 0;
+}
+
+// ============================================
+// AVX2 (32 símbolos)
+// ============================================
+
+__attribute__((target("avx2"))) static size_t validate_avx2(const char *in, size_t n, char zero, char one)
+{
+    __m256i z = _mm256_set1_epi8(zero), o = _mm256_set1_epi8(one);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+        unsigned ok =
+            (unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, z), _mm256_cmpeq_epi8(v, o)));
+        if (ok != 0xFFFFFFFFu)
+            return i + (size_t)__builtin_ctz(~ok);
+    }
+    return validate_swar(in, n, zero, one, i);
+}
+
+__attribute__((target("avx2"))) static int pack_avx2(const char *in, size_t n, uint8_t *out, char zero, char one)
+{
+    __m256i z = _mm256_set1_epi8(zero), o = _mm256_set1_epi8(one);
+    // Invierte cada grupo de 8 símbolos: así movemask deja el primero en el MSB de cada byte
+    __m256i rev = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                   7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    unsigned bad = 0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i is_one = _mm256_cmpeq_epi8(v, o);
+        unsigned ok = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, z), is_one));
+        uint32_t bits = (uint32_t)_mm256_movemask_epi8(_mm256_shuffle_epi8(is_one, rev));
+        bad |= ~ok;
+        memcpy(out + i / 8, &bits, 4);
+    }
+    int tail = pack_swar(in, n, out, zero, one, i);
+    return (bad || tail) ? -1 : 0;
+}
+
+__attribute__((target("avx2"))) static void unpack_avx2(const uint8_t *in, size_t n, char *out, char zero, char one)
+{
+    // Cada byte de entrada se replica en 8 posiciones y se prueba un bit en cada una
+    __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                      2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    __m256i mask = _mm256_set1_epi64x((long long)0x0102040810204080ULL);
+    __m256i z = _mm256_set1_epi8(zero), o = _mm256_set1_epi8(one);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        uint32_t word;
+        memcpy(&word, in + i / 8, 4);
+        // shuffle_epi8 trabaja por carriles de 128 bits: los bytes 2-3 van al carril alto
+        __m256i v = _mm256_set_epi32(0, 0, 0, (int)word, 0, 0, 0, (int)word);
+        v = _mm256_shuffle_epi8(v, spread);
+        __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(v, mask), mask);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_blendv_epi8(z, o, set));
+    }
+    unpack_swar(in, n, out, zero, one, i);
+}
+
+#endif // BITPACK_HAVE_X86
+
+// ============================================
+// Interfaz
+// ============================================
+
+size_t bits_validate(const char *in, size_t n, char zero, char one)
+{
+    pthread_once(&kernel_once, kernel_init);
+#ifdef BITPACK_HAVE_X86
+    if (kernel == KERNEL_AVX2)
+        return validate_avx2(in, n, zero, one);
+    if (kernel == KERNEL_SSE2)
+        return validate_sse2(in, n, zero, one);
+#endif
+    return validate_swar(in, n, zero, one, 0);
+}
+
+int bits_pack(const char *in, size_t n, uint8_t *out, char zero, char one)
+{
+    pthread_once(&kernel_once, kernel_init);
+#ifdef BITPACK_HAVE_X86
+    if (kernel == KERNEL_AVX2)
+        return pack_avx2(in, n, out, zero, one);
+    if (kernel == KERNEL_SSE2)
+        return pack_sse2(in, n, out, zero, one);
+#endif
+    return pack_swar(in, n, out, zero, one, 0);
+}
+
+void bits_unpack(const uint8_t *in, size_t n, char *out, char zero, char one)
+{
+    pthread_once(&kernel_once, kernel_init);
+#ifdef BITPACK_HAVE_X86
+    if (kernel == KERNEL_AVX2)
+    {
+        unpack_avx2(in, n, out, zero, one);
+        return;
+    }
+#endif
+    unpack_swar(in, n, out, zero, one, 0);
+}
+
+int bits_force_kernel(const char *name)
+{
+    pthread_once(&kernel_once, kernel_init);
+    int best = kernel_best();
+    int wanted;
+    if (name == NULL)
+        wanted = best;
+    else if (strcmp(name, "SWAR") == 0)
+        wanted = KERNEL_SWAR;
+    else if (strcmp(name, "SSE2") == 0)
+        wanted = KERNEL_SSE2;
+    else if (strcmp(name, "AVX2") == 0)
+        wanted = KERNEL_AVX2;
+    else
+        return -1;
+
+    // Las rutas están ordenadas: toda CPU que admite una admite las anteriores
+    if (wanted > best)
+        return -1;
+    kernel = wanted;
+    return 0;
+}
+
+const char *bits_kernel_name(void)
+{
+    pthread_once(&kernel_once, kernel_init);
+    return (kernel == KERNEL_AVX2) ? "AVX2" : (kernel == KERNEL_SSE2) ? "SSE2" : "SWAR";
+}
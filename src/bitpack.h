@@ -0,0 +1,61 @@
+#ifndef BITPACK_H
+#define BITPACK_H
+
+/**
+ * @file bitpack.h
+ * @brief Validación y conversión texto ↔ bits empaquetados en una pasada
+ *
+ * El texto usa un alfabeto de dos símbolos que difieren en un solo bit:
+ * '0'/'1' para bits y 'L'/'H' para niveles NRZ. Los bits empaquetados van
+ * con el primer símbolo en el MSB de cada byte (igual que pack_bitstream).
+ *
+ * Rutas (se elige la mejor disponible al primer uso):
+ * - AVX2: 32 símbolos por iteración (comparación + movemask)
+ * - SSE2: 16 símbolos por iteración
+ * - SWAR: 8 símbolos por palabra de 64 bits (sin SIMD)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Posición del primer símbolo que no es `zero` ni `one`
+ * @return Índice del primer símbolo inválido, o n si todos son válidos
+ */
+size_t bits_validate(const char *in, size_t n, char zero, char one);
+
+/**
+ * @brief Valida y empaqueta n símbolos
+ * @param in Texto de entrada (no necesita '\0')
+ * @param n Número de símbolos
+ * @param out Salida de (n + 7) / 8 bytes; los bits de relleno quedan en cero
+ * @param zero Símbolo del bit 0 ('0' o 'L')
+ * @param one Símbolo del bit 1 ('1' o 'H')
+ * @return 0 si todos los símbolos eran válidos, -1 si no (los inválidos se empaquetan como 0)
+ */
+int bits_pack(const char *in, size_t n, uint8_t *out, char zero, char one);
+
+/**
+ * @brief Convierte bits empaquetados a texto
+ * @param in Bits (primer símbolo en el MSB)
+ * @param n Número de símbolos a escribir
+ * @param out Salida de n caracteres (sin '\0')
+ */
+void bits_unpack(const uint8_t *in, size_t n, char *out, char zero, char one);
+
+/**
+ * @brief Fija la ruta en uso (para pruebas y mediciones)
+ *
+ * No es seguro llamarla mientras otro hilo empaqueta o desempaqueta.
+ *
+ * @param name "AVX2", "SSE2", "SWAR", o NULL para volver a la mejor disponible
+ * @return 0 si tuvo éxito, -1 si la ruta no existe o la CPU no la admite
+ */
+int bits_force_kernel(const char *name);
+
+/**
+ * @brief Nombre de la ruta en uso ("AVX2", "SSE2" o "SWAR")
+ */
+const char *bits_kernel_name(void);
+
+#endif // BITPACK_H
@@ -0,0 +1,44 @@
+#ifndef BITSLICE_H
+#define BITSLICE_H
+
+/**
+ * @file bitslice.h
+ * @brief Simulación Monte Carlo "bit-sliced": 64 ensayos por palabra
+ *
+ * El bit k de cada uint64_t pertenece al ensayo k. La señal codificada se
+ * replica en las 64 líneas, el ruido de 64 ensayos se genera de una vez
+ * (saltos geométricos entre bits errados), el decodificador se ejecuta una
+ * sola vez sobre las palabras y los errores por ensayo se acumulan en
+ * contadores verticales que al final se transponen.
+ *
+ * Esquemas soportados: NRZ, NRZI y Manchester (ver codec.h).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "report.h"
+
+/**
+ * @brief Ejecuta N ensayos con ruido sobre un bitstream fijo
+ * @param bitstream Cadena de bits ('0' y '1')
+ * @param ber Probabilidad de error por símbolo de línea
+ * @param N Número de ensayos
+ * @param scheme "NRZ", "NRZI" o "Manchester"
+ * @param seed Semilla del flujo de ruido
+ * @param errors Salida: N conteos de bits errados (misma convención que
+ *               run_simulations: una trama Manchester inválida cuenta como
+ *               todos los bits errados)
+ * @return 0 si tuvo éxito, -1 si el esquema o la entrada no son válidos
+ */
+int bitslice_simulate(const char *bitstream, double ber, int N, const char *scheme,
+                      uint64_t seed, int *errors);
+
+/**
+ * @brief Igual que run_simulations, pero en modo bit-sliced
+ *
+ * Agrega una fila a la tabla de resultados con el mismo formato.
+ */
+void run_simulations_sliced(Report *report, const char *bitstream, double ber, int N,
+                            const char *name, uint64_t seed);
+
+#endif // BITSLICE_H
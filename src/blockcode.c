@@ -0,0 +1,367 @@
+#include "blockcode.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================
+// Tablas incluidas
+// ============================================
+
+static const BlockCodeEntry TABLE_4B5B[] = {
+    {"0000", "11110"}, {"0001", "01001"}, {"0010", "10100"}, {"0011", "10101"},
+    {"0100", "01010"}, {"0101", "01011"}, {"0110", "01110"}, {"0111", "01111"},
+    {"1000", "10010"}, {"1001", "10011"}, {"1010", "10110"}, {"1011", "10111"},
+    {"1100", "11010"}, {"1101", "11011"}, {"1110", "11100"}, {"1111", "11101"}};
+
+// Columna RD- del subbloque 3b/4b de 8b/10b (bits HGF → fghj)
+static const BlockCodeEntry TABLE_3B4B[] = {
+    {"000", "1011"}, {"001", "1001"}, {"010", "0101"}, {"011", "1100"},
+    {"100", "1101"}, {"101", "1010"}, {"110", "0110"}, {"111", "1110"}};
+
+static BlockCode code_4b5b, code_3b4b;
+static int builtin_ok = 0;
+static pthread_once_t builtin_once = PTHREAD_ONCE_INIT;
+
+static void builtin_init(void)
+{
+    builtin_ok = block_code_init(&code_4b5b, "4B/5B", TABLE_4B5B, 16) == 0 &&
+                 block_code_init(&code_3b4b, "3B4B", TABLE_3B4B, 8) == 0;
+}
+
+const BlockCode *block_code_4b5b(void)
+{
+    pthread_once(&builtin_once, builtin_init);
+    return builtin_ok ? &code_4b5b : NULL;
+}
+
+const BlockCode *block_code_3b4b(void)
+{
+    pthread_once(&builtin_once, builtin_init);
+    return builtin_ok ? &code_3b4b : NULL;
+}
+
+// ============================================
+// Construcción y validación
+// ============================================
+
+/**
+ * Valor de una cadena de '0'/'1' de longitud exacta `len`, o -1 si no lo es
+ */
+static long parse_word(const char *s, unsigned len)
+{
+    if (!s || strlen(s) != len)
+        return -1;
+
+    long v = 0;
+    for (unsigned k = 0; k < len; k++)
+    {
+        if (s[k] != '0' && s[k] != '1')
+            return -1;
+        v = (v << 1) | (s[k] - '0');
+    }
+    return v;
+}
+
+int block_code_init(BlockCode *bc, const char *name, const BlockCodeEntry *table, size_t count)
+{
+    if (!bc || !table || count == 0)
+        return -1;
+
+    unsigned m = (unsigned)strlen(table[0].data ? table[0].data : "");
+    unsigned n = (unsigned)strlen(table[0].code ? table[0].code : "");
+    if (m == 0 || m > BLOCK_CODE_MAX_M || n < m || n > BLOCK_CODE_MAX_N)
+    {
+        fprintf(stderr, "Error: código %s de %uB%uB no soportado\n", name, m, n);
+        return -1;
+    }
+    if (count != (1u << m))
+    {
+        fprintf(stderr, "Error: el código %s necesita %u entradas (tiene %zu)\n", name, 1u << m, count);
+        return -1;
+    }
+
+    memset(bc, 0, sizeof(*bc));
+    bc->name = name;
+    bc->m = m;
+    bc->n = n;
+    memset(bc->decode, 0xFF, sizeof(bc->decode)); // -1 en todas las entradas
+
+    unsigned char seen[1u << BLOCK_CODE_MAX_M] = {0};
+    for (size_t i = 0; i < count; i++)
+    {
+        long d = parse_word(table[i].data, m);
+        long c = parse_word(table[i].code, n);
+        if (d < 0 || c < 0)
+        {
+            fprintf(stderr, "Error: entrada %zu inválida en %s (\"%s\" → \"%s\")\n", i, name,
+                    table[i].data ? table[i].data : "", table[i].code ? table[i].code : "");
+            return -1;
+        }
+        if (seen[d])
+        {
+            fprintf(stderr, "Error: datos %s repetidos en %s\n", table[i].data, name);
+            return -1;
+        }
+        if (bc->decode[c] >= 0)
+        {
+            fprintf(stderr, "Error: palabra código %s duplicada en %s\n", table[i].code, name);
+            return -1;
+        }
+
+        seen[d] = 1;
+        bc->encode[d] = (uint16_t)c;
+        bc->decode[c] = (int16_t)d;
+        memcpy(bc->encode_text[d], table[i].code, n);
+        memcpy(bc->decode_text[d], table[i].data, m);
+    }
+    // count == 2^m y sin repetidos: todos los datos quedan cubiertos
+    return 0;
+}
+
+// ============================================
+// Texto por bloques
+// ============================================
+
+int block_code_encode(const BlockCode *bc, const char *in, size_t len, char *out)
+{
+    unsigned m = bc->m, n = bc->n;
+    unsigned bad = 0;
+
+    for (size_t i = 0; i + m <= len; i += m, out += n)
+    {
+        unsigned d = 0;
+        for (unsigned k = 0; k < m; k++)
+        {
+            unsigned v = (unsigned char)in[i + k] - '0';
+            bad |= v >> 1;
+            d = (d << 1) | (v & 1);
+        }
+        memcpy(out, bc->encode_text[d], n);
+    }
+    return bad ? -1 : 0;
+}
+
+int block_code_decode(const BlockCode *bc, const char *in, size_t len, char *out)
+{
+    unsigned m = bc->m, n = bc->n;
+
+    for (size_t i = 0; i + n <= len; i += n, out += m)
+    {
+        unsigned c = 0;
+        for (unsigned k = 0; k < n; k++)
+        {
+            unsigned v = (unsigned char)in[i + k] - '0';
+            if (v > 1)
+                return -1;
+            c = (c << 1) | v;
+        }
+
+        int d = bc->decode[c];
+        if (d < 0)
+            return -1; // Palabra código desconocida
+        memcpy(out, bc->decode_text[d], m);
+    }
+    return 0;
+}
+
+/**
+ * Datos de una palabra con posiciones borradas (`mask`), o -1 si ninguna
+ * o más de una forma de completarla es una palabra código válida
+ */
+static int resolve_erasures(const BlockCode *bc, unsigned known, unsigned mask)
+{
+    int found = -1, matches = 0;
+    unsigned sub = 0;
+
+    do
+    {
+        int d = bc->decode[known | sub];
+        if (d >= 0)
+        {
+            found = d;
+            matches++;
+        }
+        sub = (sub - mask) & mask; // Siguiente subconjunto de mask
+    } while (sub != 0);
+
+    return (matches == 1) ? found : -1;
+}
+
+int block_code_decode_erasures(const BlockCode *bc, const char *in, size_t len, char *out,
+                               BlockCodeStats *stats)
+{
+    unsigned m = bc->m, n = bc->n;
+    BlockCodeStats local = {0};
+
+    for (size_t i = 0; i + n <= len; i += n, out += m)
+    {
+        unsigned c = 0, mask = 0, erased = 0;
+        for (unsigned k = 0; k < n; k++)
+        {
+            char s = in[i + k];
+            c <<= 1;
+            mask <<= 1;
+            if (s == '1')
+                c |= 1;
+            else if (s == BLOCK_ERASURE)
+            {
+                mask |= 1;
+                erased++;
+            }
+            else if (s != '0')
+                return -1;
+        }
+
+        int d = bc->decode[c];
+        if (mask != 0)
+        {
+            d = (erased <= BLOCK_CODE_MAX_ERASED) ? resolve_erasures(bc, c, mask) : -1;
+            if (d >= 0)
+                local.recovered++;
+        }
+
+        local.words++;
+        if (d < 0)
+        {
+            memset(out, BLOCK_ERASURE, m);
+            local.erased++;
+        }
+        else
+            memcpy(out, bc->decode_text[d], m);
+    }
+
+    if (stats)
+    {
+        stats->words += local.words;
+        stats->recovered += local.recovered;
+        stats->erased += local.erased;
+    }
+    return 0;
+}
+
+// ============================================
+// Streaming
+// ============================================
+
+void block_code_stream_init(BlockCodeStream *s, const BlockCode *bc, int decode)
+{
+    if (!s)
+        return;
+    memset(s, 0, sizeof(*s));
+    s->bc = bc;
+    s->decode = decode;
+}
+
+static int stream_blocks(BlockCodeStream *s, const char *in, size_t len, char *out)
+{
+    return s->decode ? block_code_decode_erasures(s->bc, in, len, out, &s->stats)
+                     : block_code_encode(s->bc, in, len, out);
+}
+
+long block_code_stream_push(BlockCodeStream *s, const char *in, size_t len, char *out)
+{
+    if (!s || !s->bc || (!in && len > 0))
+        return -1;
+
+    unsigned in_block = s->decode ? s->bc->n : s->bc->m;
+    unsigned out_block = s->decode ? s->bc->m : s->bc->n;
+    long written = 0;
+
+    // Completar el grupo que quedó a medias en el trozo anterior
+    if (s->fill > 0)
+    {
+        size_t take = in_block - s->fill;
+        if (take > len)
+            take = len;
+        memcpy(s->pending + s->fill, in, take);
+        s->fill += (unsigned)take;
+        in += take;
+        len -= take;
+
+        if (s->fill < in_block)
+            return 0;
+        if (stream_blocks(s, s->pending, in_block, out) != 0)
+            return -1;
+        s->fill = 0;
+        out += out_block;
+        written += out_block;
+    }
+
+    size_t whole = len / in_block * in_block;
+    if (stream_blocks(s, in, whole, out) != 0)
+        return -1;
+    written += (long)(whole / in_block * out_block);
+
+    s->fill = (unsigned)(len - whole);
+    memcpy(s->pending, in + whole, s->fill);
+    return written;
+}
+
+// ============================================
+// Bits empaquetados
+// ============================================
+
+size_t block_code_encode_packed(const BlockCode *bc, const uint8_t *bits, size_t nbits, uint8_t *out)
+{
+    unsigned m = bc->m, n = bc->n;
+    uint64_t racc = 0, wacc = 0;
+    unsigned rn = 0, wn = 0;
+    size_t rpos = 0, wpos = 0;
+
+    for (size_t g = 0; g < nbits / m; g++)
+    {
+        while (rn < m)
+        {
+            racc = (racc << 8) | bits[rpos++];
+            rn += 8;
+        }
+        rn -= m;
+        unsigned d = (unsigned)(racc >> rn) & ((1u << m) - 1);
+
+        wacc = (wacc << n) | bc->encode[d];
+        wn += n;
+        while (wn >= 8)
+        {
+            wn -= 8;
+            out[wpos++] = (uint8_t)(wacc >> wn);
+        }
+    }
+    if (wn > 0)
+        out[wpos] = (uint8_t)(wacc << (8 - wn));
+    return nbits / m * n;
+}
+
+size_t block_code_decode_packed(const BlockCode *bc, const uint8_t *code, size_t nbits, uint8_t *out)
+{
+    unsigned m = bc->m, n = bc->n;
+    uint64_t racc = 0, wacc = 0;
+    unsigned rn = 0, wn = 0;
+    size_t rpos = 0, wpos = 0, invalid = 0;
+
+    for (size_t g = 0; g < nbits / n; g++)
+    {
+        while (rn < n)
+        {
+            racc = (racc << 8) | code[rpos++];
+            rn += 8;
+        }
+        rn -= n;
+        int d = bc->decode[(racc >> rn) & ((1u << n) - 1)];
+        if (d < 0)
+        {
+            invalid++;
+            d = 0;
+        }
+
+        wacc = (wacc << m) | (unsigned)d;
+        wn += m;
+        while (wn >= 8)
+        {
+            wn -= 8;
+            out[wpos++] = (uint8_t)(wacc >> wn);
+        }
+    }
+    if (wn > 0)
+        out[wpos] = (uint8_t)(wacc << (8 - wn));
+    return invalid;
+}
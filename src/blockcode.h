@@ -0,0 +1,151 @@
+#ifndef BLOCKCODE_H
+#define BLOCKCODE_H
+
+/**
+ * @file blockcode.h
+ * @brief Motor genérico de códigos de bloque mBnB (4B/5B, 3B4B, propios)
+ *
+ * Un código se describe con su tabla de correspondencias (m bits de datos →
+ * n bits de código). Al inicializarlo se valida la tabla (longitudes,
+ * caracteres, datos faltantes o repetidos, palabras código duplicadas) y se
+ * construyen tablas densas de codificación (2^m entradas) y decodificación
+ * (2^n entradas, -1 para palabras inválidas), así que cada grupo se traduce
+ * con un solo acceso sin importar el esquema.
+ *
+ * Rutas disponibles para cualquier tabla:
+ * - texto ('0'/'1') por bloques, estricta o tolerante a borraduras
+ * - streaming con trozos de longitud arbitraria
+ * - bits empaquetados (primer bit en el MSB)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BLOCK_CODE_MAX_M 8
+#define BLOCK_CODE_MAX_N 12
+
+// Símbolo de borradura: en la entrada, posición ilegible; en la salida, bit perdido
+#define BLOCK_ERASURE 'X'
+
+// Máximo de borraduras por palabra que se intentan resolver
+#define BLOCK_CODE_MAX_ERASED 3
+
+typedef struct
+{
+    const char *data; // m bits de datos, ej: "0000"
+    const char *code; // n bits de código, ej: "11110"
+} BlockCodeEntry;
+
+typedef struct
+{
+    const char *name;
+    unsigned m, n;
+    uint16_t encode[1u << BLOCK_CODE_MAX_M];                 // datos → palabra código
+    int16_t decode[1u << BLOCK_CODE_MAX_N];                  // palabra → datos, -1 si no existe
+    char encode_text[1u << BLOCK_CODE_MAX_M][BLOCK_CODE_MAX_N]; // Palabra código en texto
+    char decode_text[1u << BLOCK_CODE_MAX_M][BLOCK_CODE_MAX_M]; // Datos en texto
+} BlockCode;
+
+typedef struct
+{
+    size_t words;      // Palabras decodificadas
+    size_t recovered;  // Palabras con borraduras resueltas sin ambigüedad
+    size_t erased;     // Palabras inválidas o ambiguas (salida = BLOCK_ERASURE)
+} BlockCodeStats;
+
+/**
+ * @brief Construye un código a partir de su tabla
+ * @param bc Código a inicializar
+ * @param name Nombre del esquema (no se copia)
+ * @param table Correspondencias datos → código
+ * @param count Entradas de la tabla (debe ser 2^m)
+ * @return 0 si la tabla es válida, -1 si no (con mensaje en stderr)
+ */
+int block_code_init(BlockCode *bc, const char *name, const BlockCodeEntry *table, size_t count);
+
+/**
+ * @brief Código 4B/5B estándar (FDDI / 100BASE-TX, solo símbolos de datos)
+ */
+const BlockCode *block_code_4b5b(void);
+
+/**
+ * @brief Código 3B4B de ejemplo (subbloque 3b/4b de 8b/10b, disparidad negativa)
+ */
+const BlockCode *block_code_3b4b(void);
+
+/**
+ * @brief Codifica texto por bloques
+ * @param bc Código
+ * @param in Bits ('0'/'1'), len múltiplo de m
+ * @param len Longitud de la entrada
+ * @param out Salida: len / m * n símbolos (sin '\0')
+ * @return 0 si tuvo éxito, -1 si hay caracteres inválidos
+ */
+int block_code_encode(const BlockCode *bc, const char *in, size_t len, char *out);
+
+/**
+ * @brief Decodifica texto por bloques (estricto)
+ * @return 0 si tuvo éxito, -1 si hay caracteres o palabras código inválidas
+ */
+int block_code_decode(const BlockCode *bc, const char *in, size_t len, char *out);
+
+/**
+ * @brief Decodifica texto tolerando borraduras
+ *
+ * Las posiciones BLOCK_ERASURE se completan probando todas las opciones:
+ * si exactamente una da una palabra válida se usa esa. Las palabras
+ * inválidas o ambiguas producen m símbolos BLOCK_ERASURE en la salida en
+ * lugar de abortar la decodificación.
+ *
+ * @param stats Estadísticas acumuladas (puede ser NULL)
+ * @return 0 si tuvo éxito, -1 si hay caracteres que no son '0', '1' ni BLOCK_ERASURE
+ */
+int block_code_decode_erasures(const BlockCode *bc, const char *in, size_t len, char *out,
+                               BlockCodeStats *stats);
+
+// ============================================
+// Streaming
+// ============================================
+
+typedef struct
+{
+    const BlockCode *bc;
+    int decode;                      // 0: codifica; 1: decodifica (con borraduras)
+    char pending[BLOCK_CODE_MAX_N];  // Grupo incompleto del trozo anterior
+    unsigned fill;
+    BlockCodeStats stats;
+} BlockCodeStream;
+
+/**
+ * @brief Inicializa un flujo
+ */
+void block_code_stream_init(BlockCodeStream *s, const BlockCode *bc, int decode);
+
+/**
+ * @brief Procesa un trozo de longitud arbitraria
+ * @param out Salida: como máximo (fill + len) / bloque_entrada * bloque_salida símbolos
+ * @return Símbolos escritos, o -1 si la entrada no es válida
+ */
+long block_code_stream_push(BlockCodeStream *s, const char *in, size_t len, char *out);
+
+// ============================================
+// Bits empaquetados
+// ============================================
+
+/**
+ * @brief Codifica bits empaquetados (primer bit en el MSB)
+ * @param nbits Bits de entrada (múltiplo de m)
+ * @param out Salida: (nbits / m * n + 7) / 8 bytes
+ * @return Bits escritos
+ */
+size_t block_code_encode_packed(const BlockCode *bc, const uint8_t *bits, size_t nbits, uint8_t *out);
+
+/**
+ * @brief Decodifica bits empaquetados
+ * @param nbits Bits de código (múltiplo de n)
+ * @param out Salida: (nbits / n * m + 7) / 8 bytes; las palabras inválidas dan ceros
+ * @return Número de palabras código inválidas
+ */
+size_t block_code_decode_packed(const BlockCode *bc, const uint8_t *code, size_t nbits, uint8_t *out);
+
+#endif // BLOCKCODE_H
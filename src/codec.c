@@ -0,0 +1,127 @@
+#include "codec.h"
+#include "encoding.h"
+#include "blockcode.h"
+#include <string.h>
+#include <math.h>
+
+static const LineCodec REGISTRY[] = {
+    {"NRZ", 1, 1, nrz_encode_block, nrz_decode_block, encode_nrz, decode_nrz, line_flip_symbol, NULL, NULL},
+    {"NRZI", 1, 1, nrzi_encode_block, nrzi_decode_block, encode_nrzi, decode_nrzi, line_flip_symbol,
+     ones_parity_state, last_level_state},
+    {"Manchester", 1, 2, manchester_encode_block, manchester_decode_block, encode_manchester, decode_manchester,
+     line_flip_symbol, NULL, NULL},
+    {"4B/5B", 4, 5, b4b5_encode_block, b4b5_decode_block, encode_4b5b, decode_4b5b, line_flip_symbol, NULL, NULL},
+    {"AMI", 1, 1, ami_encode_block, ami_decode_block, encode_ami, decode_ami, ternary_flip_symbol,
+     ones_parity_state, last_mark_state},
+    {"Pseudoternario", 1, 1, pseudoternary_encode_block, pseudoternary_decode_block, encode_pseudoternary,
+     decode_pseudoternary, ternary_flip_symbol, zeros_parity_state, last_mark_state},
+    {"Manchester Diferencial", 1, 2, diff_manchester_encode_block, diff_manchester_decode_block,
+     encode_diff_manchester, decode_diff_manchester, line_flip_symbol, ones_parity_state, last_half_state},
+};
+
+void line_state_init(LineState *st)
+{
+    if (st)
+        st->level = 1; // 'H'
+}
+
+char line_flip_symbol(char c)
+{
+    switch (c)
+    {
+    case 'H':
+        return 'L';
+    case 'L':
+        return 'H';
+    case '0':
+        return '1';
+    case '1':
+        return '0';
+    default:
+        return c;
+    }
+}
+
+char ternary_flip_symbol(char c)
+{
+    switch (c)
+    {
+    case '+':
+    case '-':
+        return '0';
+    case '0':
+        return '+';
+    default:
+        return c;
+    }
+}
+
+size_t line_add_noise(const LineCodec *codec, char *symbols, size_t n, double ber, Rng *rng)
+{
+    if (!symbols || ber <= 0.0)
+        return 0;
+
+    symbol_flip_fn flip = (codec && codec->flip) ? codec->flip : line_flip_symbol;
+
+    if (ber >= 1.0)
+    {
+        for (size_t j = 0; j < n; j++)
+            symbols[j] = flip(symbols[j]);
+        return n;
+    }
+
+    double inv_log = 1.0 / log1p(-ber);
+    size_t flips = 0;
+
+    for (size_t pos = 0;;)
+    {
+        double gap = floor(log(1.0 - rng_uniform(rng)) * inv_log);
+        if (gap >= (double)(n - pos))
+            break;
+        pos += (size_t)gap;
+        symbols[pos] = flip(symbols[pos]);
+        flips++;
+        if (++pos >= n)
+            break;
+    }
+    return flips;
+}
+
+size_t line_decode_erasures(const LineCodec *codec, const char *in, size_t n_sym, char *out, LineState *st)
+{
+    size_t lost = 0;
+
+    for (size_t i = 0, o = 0; i < n_sym; i += codec->out_block, o += codec->in_block)
+    {
+        LineState before = *st;
+        if (codec->decode_block(in + i, codec->out_block, out + o, st) != 0)
+        {
+            memset(out + o, BLOCK_ERASURE, codec->in_block);
+            *st = before;
+            if (codec->decode_state)
+                codec->decode_state(in + i, codec->out_block, st);
+            lost++;
+        }
+    }
+    return lost;
+}
+
+const LineCodec *codec_registry(size_t *count)
+{
+    if (count)
+        *count = sizeof(REGISTRY) / sizeof(REGISTRY[0]);
+    return REGISTRY;
+}
+
+const LineCodec *codec_find(const char *name)
+{
+    if (!name)
+        return NULL;
+
+    for (size_t i = 0; i < sizeof(REGISTRY) / sizeof(REGISTRY[0]); i++)
+    {
+        if (strcmp(REGISTRY[i].name, name) == 0)
+            return &REGISTRY[i];
+    }
+    return NULL;
+}
@@ -0,0 +1,148 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+/**
+ * @file codec.h
+ * @brief Registro de esquemas y núcleos de codificación sin asignación
+ *
+ * Cada esquema expone, además de encode_X/decode_X (que reservan memoria),
+ * un par de núcleos que escriben en un buffer del llamador y llevan el
+ * estado de línea de forma explícita. Sobre ellos se construyen los modos
+ * por lotes y por trozos (streaming).
+ */
+
+#include <stddef.h>
+#include "analysis.h"
+#include "rng.h"
+
+/**
+ * Estado de línea arrastrado entre bloques consecutivos de un mismo flujo
+ * (nivel actual en NRZI y Manchester diferencial, polaridad de la próxima
+ * marca en AMI y pseudoternario). Los esquemas sin memoria lo ignoran.
+ */
+typedef struct
+{
+    int level;
+} LineState;
+
+/**
+ * @brief Núcleo de codificación/decodificación de un bloque
+ * @param in Símbolos de entrada (no necesita terminar en '\0')
+ * @param len Número de símbolos (múltiplo del bloque del esquema)
+ * @param out Buffer de salida con espacio suficiente (sin '\0')
+ * @param st Estado de línea (se actualiza al final del bloque)
+ * @return 0 si tuvo éxito, -1 si la entrada contiene símbolos inválidos
+ */
+typedef int (*line_block_fn)(const char *in, size_t len, char *out, LineState *st);
+
+/**
+ * @brief Avanza el estado de línea sobre un bloque sin producir salida
+ *
+ * Es mucho más barato que el núcleo completo (por ejemplo, en NRZI basta la
+ * paridad de los '1'); permite calcular en paralelo el estado inicial de
+ * cada trozo de un flujo grande. NULL en esquemas sin memoria.
+ */
+typedef void (*line_state_fn)(const char *in, size_t len, LineState *st);
+
+/**
+ * @brief Error de decisión sobre un símbolo de línea
+ * @return El símbolo que recibe el receptor en lugar de c
+ */
+typedef char (*symbol_flip_fn)(char c);
+
+typedef struct
+{
+    const char *name;         // Nombre para reportes ("NRZ", "4B/5B", ...)
+    unsigned in_block;        // Bits de información por bloque
+    unsigned out_block;       // Símbolos de línea por bloque
+    line_block_fn encode_block;
+    line_block_fn decode_block;
+    encode_ptr encode;        // Versión que reserva memoria (encoding.h)
+    decode_ptr decode;
+    symbol_flip_fn flip;      // Modelo de error del canal para sus símbolos
+    line_state_fn encode_state; // Estado tras codificar un bloque (NULL: sin memoria)
+    line_state_fn decode_state; // Estado tras decodificar un bloque (NULL: sin memoria)
+} LineCodec;
+
+/**
+ * @brief Inicializa el estado de línea al nivel acordado ('H')
+ */
+void line_state_init(LineState *st);
+
+/**
+ * @brief Invierte un símbolo de línea binario ('H' <-> 'L', '0' <-> '1')
+ * @return El símbolo invertido (otros caracteres no cambian)
+ */
+char line_flip_symbol(char c);
+
+/**
+ * @brief Error de decisión en una señal ternaria ('+'/'-'/'0')
+ *
+ * Una marca se confunde con el nivel cero y un cero con una marca positiva.
+ */
+char ternary_flip_symbol(char c);
+
+/**
+ * @brief Canal binario simétrico sobre una señal de línea
+ *
+ * Invierte cada símbolo con probabilidad ber. Las posiciones se eligen con
+ * saltos geométricos, así que el coste es proporcional a los errores.
+ *
+ * @param codec Esquema de la señal (define cómo se invierte cada símbolo)
+ * @param symbols Señal a modificar (in-place, no necesita '\0')
+ * @param n Número de símbolos
+ * @param ber Probabilidad de inversión por símbolo
+ * @param rng Flujo aleatorio
+ * @return Número de símbolos invertidos
+ */
+size_t line_add_noise(const LineCodec *codec, char *symbols, size_t n, double ber, Rng *rng);
+
+/**
+ * @brief Decodifica bloque a bloque sin abortar ante bloques inválidos
+ *
+ * Cada bloque inválido produce in_block símbolos BLOCK_ERASURE ('X') y el
+ * estado de línea se resincroniza con lo recibido en ese bloque.
+ *
+ * @param in Símbolos de línea (n_sym múltiplo de out_block)
+ * @param out Buffer de n_sym / out_block * in_block bits (no puede solaparse con in)
+ * @param st Estado de línea (se actualiza)
+ * @return Número de bloques perdidos
+ */
+size_t line_decode_erasures(const LineCodec *codec, const char *in, size_t n_sym, char *out, LineState *st);
+
+/**
+ * @brief Devuelve la tabla de esquemas registrados
+ * @param count Número de esquemas (salida)
+ */
+const LineCodec *codec_registry(size_t *count);
+
+/**
+ * @brief Busca un esquema por nombre
+ * @return Puntero al esquema, o NULL si no existe
+ */
+const LineCodec *codec_find(const char *name);
+
+// Núcleos de cada esquema (implementados en encoding.c)
+int nrz_encode_block(const char *in, size_t len, char *out, LineState *st);
+int nrz_decode_block(const char *in, size_t len, char *out, LineState *st);
+int nrzi_encode_block(const char *in, size_t len, char *out, LineState *st);
+int nrzi_decode_block(const char *in, size_t len, char *out, LineState *st);
+int manchester_encode_block(const char *in, size_t len, char *out, LineState *st);
+int manchester_decode_block(const char *in, size_t len, char *out, LineState *st);
+int b4b5_encode_block(const char *in, size_t len, char *out, LineState *st);
+int b4b5_decode_block(const char *in, size_t len, char *out, LineState *st);
+int ami_encode_block(const char *in, size_t len, char *out, LineState *st);
+int ami_decode_block(const char *in, size_t len, char *out, LineState *st);
+int pseudoternary_encode_block(const char *in, size_t len, char *out, LineState *st);
+int pseudoternary_decode_block(const char *in, size_t len, char *out, LineState *st);
+int diff_manchester_encode_block(const char *in, size_t len, char *out, LineState *st);
+int diff_manchester_decode_block(const char *in, size_t len, char *out, LineState *st);
+
+// Avance de estado de los esquemas con memoria (implementados en encoding.c)
+void ones_parity_state(const char *in, size_t len, LineState *st);
+void zeros_parity_state(const char *in, size_t len, LineState *st);
+void last_level_state(const char *in, size_t len, LineState *st);
+void last_mark_state(const char *in, size_t len, LineState *st);
+void last_half_state(const char *in, size_t len, LineState *st);
+
+#endif // CODEC_H
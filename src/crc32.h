@@ -0,0 +1,37 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+/**
+ * @file crc32.h
+ * @brief CRC-32 (IEEE 802.3, polinomio reflejado 0xEDB88320)
+ *
+ * Implementación slice-by-8 (8 tablas de 256 entradas, 8 bytes por
+ * iteración) y, en x86-64 con PCLMULQDQ, plegado con multiplicación sin
+ * acarreo sobre bloques de 64 bytes. La variante se elige en tiempo de
+ * ejecución; ambas dan el mismo resultado.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Actualiza un CRC-32 con más datos (misma convención que zlib)
+ * @param crc CRC acumulado (0 para empezar)
+ * @param data Datos
+ * @param len Número de bytes
+ * @return CRC-32 de todos los datos procesados hasta ahora
+ */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief CRC-32 de un buffer completo
+ */
+uint32_t crc32_compute(const void *data, size_t len);
+
+/**
+ * @brief Indica si se usa la ruta PCLMULQDQ
+ * @return 1 si está disponible en esta CPU, 0 si se usa slice-by-8
+ */
+int crc32_has_clmul(void);
+
+#endif // CRC32_H
@@ -0,0 +1,167 @@
+#include "crn.h"
+#include "codec.h"
+#include "rng.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define CRN_MAX_SCHEMES 16
+#define CRN_Z95 1.96
+
+/**
+ * Acumulador de Welford (media y suma de cuadrados centrada)
+ */
+typedef struct
+{
+    double mean, m2;
+} Welford;
+
+static void welford_add(Welford *w, double x, int n)
+{
+    double d = x - w->mean;
+    w->mean += d / n;
+    w->m2 += d * (x - w->mean);
+}
+
+static double welford_var(const Welford *w, int n)
+{
+    return (n > 1) ? w->m2 / (n - 1) : 0;
+}
+
+int crn_compare(const char *bitstream, double ber, int N, uint64_t seed,
+                CrnResult *results, size_t max_results)
+{
+    if (!bitstream || !results || N <= 0 || !is_valid_bitstream(bitstream))
+        return -1;
+
+    size_t n_codecs;
+    const LineCodec *codecs = codec_registry(&n_codecs);
+    if (n_codecs > max_results)
+        n_codecs = max_results;
+    if (n_codecs > CRN_MAX_SCHEMES)
+        n_codecs = CRN_MAX_SCHEMES;
+
+    // Mismo mensaje para todos: múltiplo del mayor bloque de entrada
+    size_t block = 1;
+    for (size_t c = 0; c < n_codecs; c++)
+        if (codecs[c].in_block > block)
+            block = codecs[c].in_block;
+    size_t len = strlen(bitstream) / block * block;
+    if (len == 0)
+        return -1;
+
+    char *clean[CRN_MAX_SCHEMES];
+    size_t n_sym[CRN_MAX_SCHEMES];
+    size_t max_sym = 0;
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        n_sym[c] = len / codecs[c].in_block * codecs[c].out_block;
+        clean[c] = safe_malloc(n_sym[c]);
+        LineState st;
+        line_state_init(&st);
+        codecs[c].encode_block(bitstream, len, clean[c], &st);
+        if (n_sym[c] > max_sym)
+            max_sym = n_sym[c];
+    }
+
+    char *noisy = safe_malloc(max_sym);
+    char *decoded = safe_malloc(len);
+    size_t *flips = safe_malloc(max_sym * sizeof(size_t));
+    int *errors = safe_malloc(n_codecs * sizeof(int));
+    Welford acc[CRN_MAX_SCHEMES] = {{0}}, diff[CRN_MAX_SCHEMES] = {{0}};
+
+    double inv_log = (ber > 0 && ber < 1) ? 1.0 / log1p(-ber) : 0;
+    Rng rng;
+    rng_seed(&rng, seed);
+
+    for (int t = 1; t <= N; t++)
+    {
+        // Realización común: posiciones j con u_j < ber (saltos geométricos)
+        size_t n_flips = 0;
+        if (ber >= 1.0)
+        {
+            for (size_t j = 0; j < max_sym; j++)
+                flips[n_flips++] = j;
+        }
+        else if (ber > 0.0)
+        {
+            for (size_t pos = 0;;)
+            {
+                double gap = floor(log(1.0 - rng_uniform(&rng)) * inv_log);
+                if (gap >= (double)(max_sym - pos))
+                    break;
+                pos += (size_t)gap;
+                flips[n_flips++] = pos;
+                if (++pos >= max_sym)
+                    break;
+            }
+        }
+
+        for (size_t c = 0; c < n_codecs; c++)
+        {
+            memcpy(noisy, clean[c], n_sym[c]);
+            for (size_t i = 0; i < n_flips && flips[i] < n_sym[c]; i++)
+                noisy[flips[i]] = codecs[c].flip(noisy[flips[i]]);
+
+            LineState st;
+            line_state_init(&st);
+            if (codecs[c].decode_block(noisy, n_sym[c], decoded, &st) != 0)
+            {
+                errors[c] = (int)len; // Misma convención que run_simulations
+            }
+            else
+            {
+                errors[c] = 0;
+                for (size_t i = 0; i < len; i++)
+                    errors[c] += (decoded[i] != bitstream[i]);
+            }
+
+            welford_add(&acc[c], errors[c], t);
+            welford_add(&diff[c], errors[c] - errors[0], t);
+        }
+    }
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        double var = welford_var(&acc[c], N);
+        double var_ref = welford_var(&acc[0], N);
+
+        results[c].name = codecs[c].name;
+        results[c].mean = acc[c].mean;
+        results[c].ci = CRN_Z95 * sqrt(var / N);
+        results[c].diff_mean = diff[c].mean;
+        results[c].diff_ci = CRN_Z95 * sqrt(welford_var(&diff[c], N) / N);
+        results[c].indep_ci = (c == 0) ? 0 : CRN_Z95 * sqrt((var + var_ref) / N);
+        free(clean[c]);
+    }
+
+    free(noisy);
+    free(decoded);
+    free(flips);
+    free(errors);
+    return (int)n_codecs;
+}
+
+void run_crn_comparison(Report *report, const char *bitstream, double ber, int N, uint64_t seed)
+{
+    CrnResult results[CRN_MAX_SCHEMES];
+    int n = crn_compare(bitstream, ber, N, seed, results, CRN_MAX_SCHEMES);
+    if (!report || n <= 0)
+        return;
+
+    report_printf(report, "\n### 7. Comparación con Ruido Común (N=%d, BER=%.3f)\n", N, ber);
+    report_printf(report, "Diferencias pareadas respecto a %s; IC del 95%%.\n\n", results[0].name);
+
+    char columns[160];
+    snprintf(columns, sizeof(columns), "Esquema\tMedia Errores\tDiferencia vs %s\tIC Pareado\tIC Independiente",
+             results[0].name);
+    report_table_begin(report, "Comparación con ruido común", columns);
+
+    for (int c = 0; c < n; c++)
+    {
+        report_row(report, 0, "%s\t%.2f ± %.2f\t%+.2f\t± %.2f\t± %.2f", results[c].name, results[c].mean,
+                   results[c].ci, results[c].diff_mean, results[c].diff_ci, results[c].indep_ci);
+    }
+}
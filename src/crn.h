@@ -0,0 +1,47 @@
+#ifndef CRN_H
+#define CRN_H
+
+/**
+ * @file crn.h
+ * @brief Comparación de esquemas con números aleatorios comunes (CRN)
+ *
+ * En cada ensayo se genera UNA realización de ruido (un flujo de uniformes
+ * u_j, un valor por posición de símbolo) y todos los esquemas registrados
+ * la usan: el símbolo j de cualquier esquema se invierte si u_j < BER.
+ * Las diferencias entre esquemas se miden por pares sobre el mismo ruido,
+ * lo que reduce la varianza frente a simulaciones independientes.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "report.h"
+
+typedef struct
+{
+    const char *name;
+    double mean;       // Media de bits errados por ensayo
+    double ci;         // Semiancho del IC 95% de la media
+    double diff_mean;  // Media de (errores esquema - errores referencia)
+    double diff_ci;    // Semiancho del IC 95% de la diferencia pareada
+    double indep_ci;   // Semiancho que tendría con ruido independiente
+} CrnResult;
+
+/**
+ * @brief Ejecuta N ensayos con ruido común para todos los esquemas
+ * @param bitstream Mensaje (se recorta a múltiplo del bloque de todos los esquemas)
+ * @param ber Probabilidad de error por símbolo
+ * @param N Número de ensayos
+ * @param seed Semilla del flujo común
+ * @param results Salida: un elemento por esquema; el primero es la referencia
+ * @param max_results Capacidad de results
+ * @return Número de esquemas comparados, o -1 si hubo error
+ */
+int crn_compare(const char *bitstream, double ber, int N, uint64_t seed,
+                CrnResult *results, size_t max_results);
+
+/**
+ * @brief Agrega al reporte la tabla de diferencias pareadas
+ */
+void run_crn_comparison(Report *report, const char *bitstream, double ber, int N, uint64_t seed);
+
+#endif // CRN_H
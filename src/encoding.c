@@ -1,4 +1,7 @@
 #include "encoding.h"
+#include "codec.h"
+#include "blockcode.h"
+#include "arena.h"
 #include "utils.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,9 +13,40 @@
 // NRZ (Non-Return to Zero)
 // ============================================
 
+int nrz_encode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    (void)st; // NRZ no tiene memoria
+    unsigned bad = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned v = (unsigned char)in[i] - '0';
+        bad |= v >> 1; // distinto de 0 si no era '0' ni '1'
+        out[i] = "LH"[v & 1];
+    }
+    return bad ? -1 : 0;
+}
+
+int nrz_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    (void)st;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        char upper_c = toupper((unsigned char)in[i]);
+
+        if (upper_c == 'H')
+            out[i] = '1';
+        else if (upper_c == 'L')
+            out[i] = '0';
+        else
+            return -1;
+    }
+    return 0;
+}
+
 char *encode_nrz(const char *bitstream)
 {
-    // TODO: Implementar
     // En NRZ: '1' = nivel alto, '0' = nivel bajo
 
     if (bitstream == NULL)
@@ -28,14 +62,10 @@ char *encode_nrz(const char *bitstream)
     }
 
     size_t length = strlen(bitstream);
-    char *encoded = safe_malloc(length + 1);
+    char *encoded = current_alloc(length + 1);
 
-    // Codificamos bit a bit
-
-    for (size_t i = 0; i < length; i++)
-    {
-        encoded[i] = (bitstream[i] == '1') ? 'H' : 'L'; // 'H' de High, 'L' para Low xd
-    }
+    // Codificamos bit a bit ('H' de High, 'L' para Low)
+    nrz_encode_block(bitstream, length, encoded, NULL);
 
     // Null-terminamos la cadena
     encoded[length] = '\0';
@@ -52,27 +82,14 @@ char *decode_nrz(const char *encoded)
     }
 
     size_t length = strlen(encoded);
-    char *decoded = safe_malloc(length + 1);
+    char *decoded = current_alloc(length + 1);
 
-    for (size_t i = 0; i < length; i++)
+    if (nrz_decode_block(encoded, length, decoded, NULL) != 0)
     {
-        char c = encoded[i];
-        char upper_c = toupper(c);
-
-        if (upper_c == 'H')
-        {
-            decoded[i] = '1';
-        }
-        else if (upper_c == 'L')
-        {
-            decoded[i] = '0';
-        }
-        else
-        {
-            fprintf(stderr, "Error: Carácter inválido '%c' en posición %zu\n", c, i);
-            free(decoded);
-            return NULL;
-        }
+        size_t i = strspn(encoded, "HLhl");
+        fprintf(stderr, "Error: Carácter inválido '%c' en posición %zu\n", encoded[i], i);
+        current_free(decoded);
+        return NULL;
     }
 
     decoded[length] = '\0';
@@ -83,6 +100,43 @@ char *decode_nrz(const char *encoded)
 // NRZI (Non-Return to Zero Inverted)
 // ============================================
 
+int nrzi_encode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    int level = st->level; // 1 = 'H', 0 = 'L'
+    unsigned bad = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned v = (unsigned char)in[i] - '0';
+        bad |= v >> 1;
+        level ^= (int)(v & 1); // un '1' invierte el nivel
+        out[i] = "LH"[level];
+    }
+
+    st->level = level;
+    return bad ? -1 : 0;
+}
+
+int nrzi_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    int prev = st->level;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        char curr = toupper((unsigned char)in[i]);
+
+        if (curr != 'H' && curr != 'L')
+            return -1;
+
+        int level = (curr == 'H');
+        out[i] = (level != prev) ? '1' : '0';
+        prev = level;
+    }
+
+    st->level = prev;
+    return 0;
+}
+
 char *encode_nrzi(const char *bitstream)
 {
     if (!is_valid_bitstream(bitstream))
@@ -93,17 +147,11 @@ char *encode_nrzi(const char *bitstream)
 
     size_t length = strlen(bitstream);
 
-    char *encoded = safe_malloc(length + 1);
-    char current_level = 'H'; // Nivel inicial fijo para tu proyecto
+    char *encoded = current_alloc(length + 1);
+    LineState st;
+    line_state_init(&st); // Nivel inicial fijo para tu proyecto ('H')
 
-    for (size_t i = 0; i < length; i++)
-    {
-        if (bitstream[i] == '1')
-        {
-            current_level = (current_level == 'H') ? 'L' : 'H';
-        }
-        encoded[i] = current_level;
-    }
+    nrzi_encode_block(bitstream, length, encoded, &st);
 
     encoded[length] = '\0';
     return encoded;
@@ -118,23 +166,16 @@ char *decode_nrzi(const char *encoded)
     }
 
     size_t length = strlen(encoded);
-    char *decoded = safe_malloc(length + 1);
+    char *decoded = current_alloc(length + 1);
 
-    char prev = 'H'; // Nivel inicial ACORDADO
+    LineState st;
+    line_state_init(&st); // Nivel inicial ACORDADO ('H')
 
-    for (size_t i = 0; i < length; i++)
+    if (nrzi_decode_block(encoded, length, decoded, &st) != 0)
     {
-        char curr = toupper(encoded[i]);
-
-        if (curr != 'H' && curr != 'L')
-        {
-            fprintf(stderr, "Error: encoded contiene caracteres inválidos\n");
-            free(decoded);
-            return NULL;
-        }
-
-        decoded[i] = (curr != prev) ? '1' : '0';
-        prev = curr;
+        fprintf(stderr, "Error: encoded contiene caracteres inválidos\n");
+        current_free(decoded);
+        return NULL;
     }
 
     decoded[length] = '\0';
@@ -145,49 +186,66 @@ char *decode_nrzi(const char *encoded)
 // Manchester
 // ============================================
 
-char *encode_manchester(const char *bitstream)
+int manchester_encode_block(const char *in, size_t len, char *out, LineState *st)
 {
-    // TODO: Implementar
     // En Manchester: '0' = transición bajo->alto, '1' = transición alto->bajo
+    (void)st;
+    unsigned bad = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned v = (unsigned char)in[i] - '0';
+        bad |= v >> 1;
+        out[2 * i] = (char)('0' + (v & 1));
+        out[2 * i + 1] = (char)('1' - (v & 1));
+    }
+    return bad ? -1 : 0;
+}
+
+int manchester_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    (void)st;
+
+    for (size_t i = 0, j = 0; i < len; i += 2, j++)
+    {
+        char a = in[i];
+        char b = in[i + 1];
+
+        if (a == '0' && b == '1')
+            out[j] = '0';
+        else if (a == '1' && b == '0')
+            out[j] = '1';
+        else
+            return -1; // Secuencia inválida
+    }
+    return 0;
+}
+
+char *encode_manchester(const char *bitstream)
+{
     // (o viceversa según convención IEEE/Thomas)
 
     if (!bitstream)
         return NULL;
 
     size_t len = strlen(bitstream);
-    char *out = malloc(len * 2 + 1);
+    char *out = current_alloc(len * 2 + 1);
     if (!out)
         return NULL;
 
-    size_t j = 0;
-
-    for (size_t i = 0; i < len; i++)
+    if (manchester_encode_block(bitstream, len, out, NULL) != 0)
     {
-        if (bitstream[i] == '0')
-        {
-            out[j++] = '0';
-            out[j++] = '1';
-        }
-        else if (bitstream[i] == '1')
-        {
-            out[j++] = '1';
-            out[j++] = '0';
-        }
-        else
-        {
-            // Carácter inválido
-            free(out);
-            return NULL;
-        }
+        // Carácter inválido
+        current_free(out);
+        return NULL;
     }
 
-    out[j] = '\0';
+    out[len * 2] = '\0';
     return out;
 }
 
 char *decode_manchester(const char *encoded)
 {
-    // TODO: Implementar
     if (!encoded)
         return NULL;
 
@@ -198,34 +256,17 @@ char *decode_manchester(const char *encoded)
         return NULL;
     }
 
-    char *out = malloc(len / 2 + 1);
+    char *out = current_alloc(len / 2 + 1);
     if (!out)
         return NULL;
 
-    size_t j = 0;
-
-    for (size_t i = 0; i < len; i += 2)
+    if (manchester_decode_block(encoded, len, out, NULL) != 0)
     {
-        char a = encoded[i];
-        char b = encoded[i + 1];
-
-        if (a == '0' && b == '1')
-        {
-            out[j++] = '0';
-        }
-        else if (a == '1' && b == '0')
-        {
-            out[j++] = '1';
-        }
-        else
-        {
-            // Secuencia inválida
-            free(out);
-            return NULL;
-        }
+        current_free(out);
+        return NULL;
     }
 
-    out[j] = '\0';
+    out[len / 2] = '\0';
     return out;
 }
 
@@ -233,33 +274,22 @@ char *decode_manchester(const char *encoded)
 // 4B/5B
 // ============================================
 
-typedef struct
-{
-    const char *b4;
-    const char *b5;
-} Code4B5B;
-
-static const Code4B5B TABLE_4B5B[] = {
-    {"0000", "11110"},
-    {"0001", "01001"},
-    {"0010", "10100"},
-    {"0011", "10101"},
-    {"0100", "01010"},
-    {"0101", "01011"},
-    {"0110", "01110"},
-    {"0111", "01111"},
-    {"1000", "10010"},
-    {"1001", "10011"},
-    {"1010", "10110"},
-    {"1011", "10111"},
-    {"1100", "11010"},
-    {"1101", "11011"},
-    {"1110", "11100"},
-    {"1111", "11101"}};
+// La tabla y sus índices densos viven en el motor mBnB (blockcode.c)
+
+int b4b5_encode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    (void)st;
+    return block_code_encode(block_code_4b5b(), in, len, out);
+}
+
+int b4b5_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    (void)st;
+    return block_code_decode(block_code_4b5b(), in, len, out);
+}
 
 char *encode_4b5b(const char *bitstream)
 {
-    // TODO: Implementar
     // Cada grupo de 4 bits se convierte en 5 bits según tabla estándar
     if (!is_valid_bitstream(bitstream))
     {
@@ -275,95 +305,292 @@ char *encode_4b5b(const char *bitstream)
     }
 
     size_t groups = len / 4;
-    char *encoded = safe_malloc(groups * 5 + 1);
+    char *encoded = current_alloc(groups * 5 + 1);
 
-    char chunk[5];
-    chunk[4] = '\0';
+    b4b5_encode_block(bitstream, len, encoded, NULL);
 
-    size_t pos = 0;
+    encoded[groups * 5] = '\0';
+    return encoded;
+}
 
-    for (size_t i = 0; i < groups; i++)
+char *decode_4b5b(const char *encoded)
+{
+    if (!is_valid_bitstream(encoded))
     {
+        fprintf(stderr, "Error: encoded inválido en 4B5B\n");
+        return NULL;
+    }
 
-        memcpy(chunk, &bitstream[i * 4], 4);
+    size_t len = strlen(encoded);
+    if (len % 5 != 0)
+    {
+        fprintf(stderr, "Error: longitud %zu no es múltiplo de 5\n", len);
+        return NULL;
+    }
 
-        int found = 0;
+    size_t groups = len / 5;
+    char *decoded = current_alloc(groups * 4 + 1);
 
-        for (int j = 0; j < 16; j++)
-        {
-            if (strcmp(chunk, TABLE_4B5B[j].b4) == 0)
-            {
-                memcpy(&encoded[pos], TABLE_4B5B[j].b5, 5);
-                pos += 5;
-                found = 1;
-                break;
-            }
-        }
+    if (b4b5_decode_block(encoded, len, decoded, NULL) != 0)
+    {
+        current_free(decoded);
+        return NULL;
+    }
 
-        if (!found)
-        {
-            fprintf(stderr, "Error: No se encontró codificación para %s\n", chunk);
-            free(encoded);
-            return NULL;
-        }
+    decoded[groups * 4] = '\0';
+    return decoded;
+}
+
+// ============================================
+// AMI y pseudoternario
+// ============================================
+
+/**
+ * Núcleo común: `mark_bit` es el valor de bit que produce una marca
+ * ('1' en AMI, '0' en pseudoternario). st->level = 1 si la próxima marca
+ * es positiva.
+ */
+static int bipolar_encode(const char *in, size_t len, char *out, LineState *st, unsigned mark_bit)
+{
+    unsigned plus = (unsigned)st->level & 1;
+    unsigned bad = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned v = (unsigned char)in[i] - '0';
+        bad |= v >> 1;
+        unsigned mark = ((v & 1) == mark_bit);
+        // índice 0: cero, 1: marca negativa, 2: marca positiva
+        out[i] = "0-+"[mark + (mark & plus)];
+        plus ^= mark;
+    }
+
+    st->level = (int)plus;
+    return bad ? -1 : 0;
+}
+
+static int bipolar_decode(const char *in, size_t len, char *out, LineState *st, unsigned mark_bit)
+{
+    unsigned plus = (unsigned)st->level & 1;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        char c = in[i];
+        unsigned mark = (c == '+' || c == '-');
+
+        if (!mark && c != '0')
+            return -1;
+
+        out[i] = (char)('0' + (mark ? mark_bit : 1 - mark_bit));
+        if (mark)
+            plus = (c == '-'); // Tras una marca '+' la siguiente debe ser '-'
+    }
+
+    st->level = (int)plus;
+    return 0;
+}
+
+int ami_encode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    return bipolar_encode(in, len, out, st, 1);
+}
+
+int ami_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    return bipolar_decode(in, len, out, st, 1);
+}
+
+int pseudoternary_encode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    return bipolar_encode(in, len, out, st, 0);
+}
+
+int pseudoternary_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    return bipolar_decode(in, len, out, st, 0);
+}
+
+/**
+ * Envoltorio común para los esquemas de un símbolo por bit que reservan
+ * memoria: valida, reserva y llama al núcleo desde el estado inicial.
+ */
+static char *encode_with(line_block_fn fn, const char *bitstream, unsigned ratio, const char *name)
+{
+    if (!is_valid_bitstream(bitstream))
+    {
+        fprintf(stderr, "Error: bitstream inválido en %s\n", name);
+        return NULL;
     }
 
-    encoded[pos] = '\0';
+    size_t len = strlen(bitstream);
+    char *encoded = current_alloc(len * ratio + 1);
+    LineState st;
+    line_state_init(&st);
+
+    fn(bitstream, len, encoded, &st);
+    encoded[len * ratio] = '\0';
     return encoded;
 }
 
-char *decode_4b5b(const char *encoded)
+static char *decode_with(line_block_fn fn, const char *encoded, unsigned ratio, const char *name)
 {
-    // TODO: Implementar
-    if (!is_valid_bitstream(encoded))
+    if (!encoded)
     {
-        fprintf(stderr, "Error: encoded inválido en 4B5B\n");
+        fprintf(stderr, "Error: encoded es NULL\n");
         return NULL;
     }
 
     size_t len = strlen(encoded);
-    if (len % 5 != 0)
+    if (len % ratio != 0)
     {
-        fprintf(stderr, "Error: longitud %zu no es múltiplo de 5\n", len);
+        fprintf(stderr, "Error: longitud %zu inválida en %s\n", len, name);
         return NULL;
     }
 
-    size_t groups = len / 5;
-    char *decoded = safe_malloc(groups * 4 + 1);
+    char *decoded = current_alloc(len / ratio + 1);
+    LineState st;
+    line_state_init(&st);
+
+    if (fn(encoded, len, decoded, &st) != 0)
+    {
+        current_free(decoded);
+        return NULL;
+    }
+
+    decoded[len / ratio] = '\0';
+    return decoded;
+}
+
+char *encode_ami(const char *bitstream)
+{
+    return encode_with(ami_encode_block, bitstream, 1, "AMI");
+}
+
+char *decode_ami(const char *encoded)
+{
+    return decode_with(ami_decode_block, encoded, 1, "AMI");
+}
+
+char *encode_pseudoternary(const char *bitstream)
+{
+    return encode_with(pseudoternary_encode_block, bitstream, 1, "pseudoternario");
+}
+
+char *decode_pseudoternary(const char *encoded)
+{
+    return decode_with(pseudoternary_decode_block, encoded, 1, "pseudoternario");
+}
+
+// ============================================
+// Manchester diferencial
+// ============================================
+
+int diff_manchester_encode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    unsigned level = (unsigned)st->level & 1;
+    unsigned bad = 0;
 
-    char chunk[6];
-    chunk[5] = '\0';
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned v = (unsigned char)in[i] - '0';
+        bad |= v >> 1;
+        unsigned first = level ^ (~v & 1); // '0' cambia de nivel al inicio
+        out[2 * i] = (char)('0' + first);
+        out[2 * i + 1] = (char)('1' - first);
+        level = first ^ 1;
+    }
 
-    size_t pos = 0;
+    st->level = (int)level;
+    return bad ? -1 : 0;
+}
 
-    for (size_t i = 0; i < groups; i++)
+int diff_manchester_decode_block(const char *in, size_t len, char *out, LineState *st)
+{
+    unsigned level = (unsigned)st->level & 1;
+
+    for (size_t i = 0, j = 0; i < len; i += 2, j++)
     {
+        unsigned a = (unsigned char)in[i] - '0';
+        unsigned b = (unsigned char)in[i + 1] - '0';
 
-        memcpy(chunk, &encoded[i * 5], 5);
+        if ((a | b) > 1 || a == b)
+            return -1; // Falta la transición de mitad de bit
 
-        int found = 0;
+        out[j] = (char)('0' + (a == level));
+        level = b;
+    }
 
-        for (int j = 0; j < 16; j++)
-        {
-            if (strcmp(chunk, TABLE_4B5B[j].b5) == 0)
-            {
-                memcpy(&decoded[pos], TABLE_4B5B[j].b4, 4);
-                pos += 4;
-                found = 1;
-                break;
-            }
-        }
+    st->level = (int)level;
+    return 0;
+}
+
+char *encode_diff_manchester(const char *bitstream)
+{
+    return encode_with(diff_manchester_encode_block, bitstream, 2, "Manchester diferencial");
+}
+
+char *decode_diff_manchester(const char *encoded)
+{
+    return decode_with(diff_manchester_decode_block, encoded, 2, "Manchester diferencial");
+}
+
+// ============================================
+// Avance de estado (para codificar/decodificar por trozos en paralelo)
+// ============================================
+
+/**
+ * NRZI, AMI y Manchester diferencial: cada '1' invierte el estado
+ */
+void ones_parity_state(const char *in, size_t len, LineState *st)
+{
+    unsigned parity = 0;
+    for (size_t i = 0; i < len; i++)
+        parity ^= (unsigned char)in[i] & 1; // '1' = 0x31, '0' = 0x30
+    st->level ^= (int)parity;
+}
+
+/**
+ * Pseudoternario: cada '0' invierte la polaridad de la próxima marca
+ */
+void zeros_parity_state(const char *in, size_t len, LineState *st)
+{
+    unsigned parity = (unsigned)len & 1;
+    for (size_t i = 0; i < len; i++)
+        parity ^= (unsigned char)in[i] & 1;
+    st->level ^= (int)parity;
+}
 
-        if (!found)
+/**
+ * Decodificador NRZI: el estado es el último nivel recibido
+ */
+void last_level_state(const char *in, size_t len, LineState *st)
+{
+    if (len > 0)
+        st->level = (toupper((unsigned char)in[len - 1]) == 'H');
+}
+
+/**
+ * Decodificador AMI/pseudoternario: la polaridad esperada depende de la última marca
+ */
+void last_mark_state(const char *in, size_t len, LineState *st)
+{
+    for (size_t i = len; i-- > 0;)
+    {
+        if (in[i] == '+' || in[i] == '-')
         {
-            // fprintf(stderr, "Error: Secuencia 5B desconocida: %s\n", chunk);
-            free(decoded);
-            return NULL;
+            st->level = (in[i] == '-');
+            return;
         }
     }
+}
 
-    decoded[pos] = '\0';
-    return decoded;
+/**
+ * Decodificador Manchester diferencial: el estado es el último medio nivel
+ */
+void last_half_state(const char *in, size_t len, LineState *st)
+{
+    if (len > 0)
+        st->level = (in[len - 1] == '1');
 }
 
 // ============================================
@@ -399,6 +626,14 @@ static int level_from_char(char c)
     }
 }
 
+/**
+ * Nivel de un símbolo ternario: '+' → 1, '0' → 0, '-' → -1
+ */
+static int ternary_level(char c)
+{
+    return (c == '+') ? 1 : (c == '-') ? -1 : 0;
+}
+
 /**
  * @brief Genera un diagrama de la señal codificada y lo guarda en un archivo de texto
  * @param encoded Cadena codificada (niveles 'H'/'L')
@@ -410,14 +645,24 @@ void plot_signal(const char *encoded, const char *filename)
     if (!encoded || !filename)
         return;
 
+    FILE *f = fopen(filename, "a"); // Append
+    if (!f)
+        return;
+
+    plot_signal_to(f, encoded);
+    fclose(f);
+}
+
+void plot_signal_to(FILE *f, const char *encoded)
+{
+    if (!f || !encoded)
+        return;
+
     size_t len = strlen(encoded);
     if (len == 0)
         return;
     const char *cedula = "30532641";
     double ber = 0.01;
-    FILE *f = fopen(filename, "a"); // Append
-    if (!f)
-        return;
 
     fprintf(f, "\n========================================\n");
     fprintf(f, "Cédula: %s | BER: %.2f\n", cedula, ber);
@@ -441,6 +686,9 @@ void plot_signal(const char *encoded, const char *filename)
         }
     }
 
+    // Señales ternarias (AMI, pseudoternario): '0' es el nivel cero, no el bajo
+    int is_ternary = (strpbrk(encoded, "+-") != NULL);
+
     // Línea de tiempos
     fprintf(f, "Tiempo: ");
     for (size_t i = 0; i < len; i++)
@@ -449,11 +697,11 @@ void plot_signal(const char *encoded, const char *filename)
 
     // Línea de señal
     fprintf(f, "Señal:  ");
-    int prev = level_from_char(encoded[0]);
+    int prev = is_ternary ? ternary_level(encoded[0]) : level_from_char(encoded[0]);
 
     for (size_t i = 0; i < len; i++)
     {
-        int lvl = level_from_char(encoded[i]);
+        int lvl = is_ternary ? ternary_level(encoded[i]) : level_from_char(encoded[i]);
         if (i > 0 && lvl != prev)
             fprintf(f, "|");
         else
@@ -462,7 +710,9 @@ void plot_signal(const char *encoded, const char *filename)
         // Modificación sugerida dentro de plot_signal
         if (lvl == 1)
             fprintf(f, "----"); // Representa nivel alto
-        else if (lvl == 0)
+        else if (is_ternary && lvl == 0)
+            fprintf(f, "...."); // Nivel cero de una señal ternaria
+        else if (lvl == 0 || (is_ternary && lvl == -1))
             fprintf(f, "____"); // Representa nivel bajo
         else
             fprintf(f, "????");
@@ -475,8 +725,6 @@ void plot_signal(const char *encoded, const char *filename)
     }
 
     fprintf(f, "\n");
-
-    fclose(f);
 }
 
 // ============================================
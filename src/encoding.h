@@ -10,8 +10,17 @@
  * - NRZI (Non-Return to Zero Inverted)
  * - Manchester
  * - 4B/5B
+ * - AMI y pseudoternario (ternarios: '+', '-', '0')
+ * - Manchester diferencial
+ *
+ * Las funciones que devuelven memoria dinámica la reservan con
+ * current_alloc (arena.h): si el hilo tiene una arena actual, el resultado
+ * vive en ella hasta el próximo arena_reset y no debe pasarse a free
+ * (current_free es válido en ambos casos).
  */
 
+#include <stdio.h>
+
 // ============================================
 // NRZ (Non-Return to Zero)
 // ============================================
@@ -84,6 +93,72 @@ char *encode_4b5b(const char *bitstream);
  */
 char *decode_4b5b(const char *encoded);
 
+// ============================================
+// AMI (Alternate Mark Inversion, bipolar)
+// ============================================
+
+/**
+ * @brief Codifica un bitstream usando AMI
+ *
+ * '0' = nivel cero ('0'); '1' = marca de polaridad alternada ('+', '-', ...).
+ * La primera marca es positiva.
+ *
+ * @param bitstream Cadena de bits ('0' y '1')
+ * @return Cadena codificada (memoria dinámica, debe liberarse con free)
+ */
+char *encode_ami(const char *bitstream);
+
+/**
+ * @brief Decodifica una señal AMI (cualquier marca vale '1')
+ * @param encoded Señal codificada ('+', '-', '0')
+ * @return Bitstream original (memoria dinámica, debe liberarse con free)
+ */
+char *decode_ami(const char *encoded);
+
+// ============================================
+// Pseudoternario
+// ============================================
+
+/**
+ * @brief Codifica un bitstream usando pseudoternario (AMI con los bits invertidos)
+ *
+ * '1' = nivel cero; '0' = marca de polaridad alternada.
+ *
+ * @param bitstream Cadena de bits ('0' y '1')
+ * @return Cadena codificada (memoria dinámica, debe liberarse con free)
+ */
+char *encode_pseudoternary(const char *bitstream);
+
+/**
+ * @brief Decodifica una señal pseudoternaria
+ * @param encoded Señal codificada ('+', '-', '0')
+ * @return Bitstream original (memoria dinámica, debe liberarse con free)
+ */
+char *decode_pseudoternary(const char *encoded);
+
+// ============================================
+// Manchester diferencial
+// ============================================
+
+/**
+ * @brief Codifica un bitstream usando Manchester diferencial
+ *
+ * Siempre hay transición a mitad de bit; un '0' además cambia de nivel al
+ * inicio del bit y un '1' no. Cada bit son dos medios niveles ('0'/'1'),
+ * partiendo del nivel alto.
+ *
+ * @param bitstream Cadena de bits ('0' y '1')
+ * @return Cadena codificada (memoria dinámica, debe liberarse con free)
+ */
+char *encode_diff_manchester(const char *bitstream);
+
+/**
+ * @brief Decodifica una señal Manchester diferencial
+ * @param encoded Señal codificada (longitud par)
+ * @return Bitstream original (memoria dinámica, debe liberarse con free)
+ */
+char *decode_diff_manchester(const char *encoded);
+
 // ============================================
 // Visualización de señales
 // ============================================
@@ -95,6 +170,16 @@ char *decode_4b5b(const char *encoded);
  */
 void plot_signal(const char *encoded, const char *filename);
 
+/**
+ * @brief Igual que plot_signal, pero sobre un archivo ya abierto
+ *
+ * Permite escribir muchos diagramas con una sola apertura del archivo.
+ *
+ * @param f Archivo de salida (no se cierra)
+ * @param encoded Señal codificada
+ */
+void plot_signal_to(FILE *f, const char *encoded);
+
 // ============================================
 // Simulación de ruido
 // ============================================
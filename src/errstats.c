@@ -0,0 +1,393 @@
+#define _POSIX_C_SOURCE 200809L
+#include "errstats.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Tramos del mapa de calor en el reporte (un dígito por tramo)
+#define HEAT_STRIP 32
+
+// ============================================
+// Acumulador
+// ============================================
+
+int error_stats_init(ErrorStats *s, size_t max_errors, size_t n_pos)
+{
+    if (!s)
+        return -1;
+    memset(s, 0, sizeof(*s));
+    s->max_errors = max_errors;
+    s->n_pos = n_pos;
+    s->min = (int)max_errors;
+    s->hist = calloc(max_errors + 1, sizeof(size_t));
+    s->heat = (n_pos > 0) ? calloc(n_pos, sizeof(size_t)) : NULL;
+    if (!s->hist || (n_pos > 0 && !s->heat))
+    {
+        fprintf(stderr, "Error: no se pudo reservar el histograma de errores\n");
+        error_stats_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+void error_stats_add(ErrorStats *s, int errors)
+{
+    if (errors < 0)
+        errors = 0;
+    if ((size_t)errors > s->max_errors)
+        errors = (int)s->max_errors;
+
+    s->trials++;
+    double d = errors - s->mean;
+    s->mean += d / (double)s->trials;
+    s->m2 += d * (errors - s->mean);
+
+    if (errors < s->min)
+        s->min = errors;
+    if (errors > s->max)
+        s->max = errors;
+    s->hist[errors]++;
+}
+
+void error_stats_add_positions(ErrorStats *s, const char *orig, const char *dec)
+{
+    int in_burst = 0;
+    for (size_t i = 0; i < s->n_pos; i++)
+    {
+        int wrong = (orig[i] != dec[i]);
+        s->heat[i] += (size_t)wrong;
+        s->bursts += (size_t)(wrong && !in_burst);
+        in_burst = wrong;
+    }
+}
+
+int error_stats_merge(ErrorStats *dst, const ErrorStats *src)
+{
+    if (!dst || !src || dst->max_errors != src->max_errors || dst->n_pos != src->n_pos)
+        return -1;
+    if (src->trials == 0)
+        return 0;
+
+    // Chan et al.: combinación de dos pares (media, M2)
+    double na = (double)dst->trials, nb = (double)src->trials;
+    double delta = src->mean - dst->mean;
+    double n = na + nb;
+    dst->mean += delta * nb / n;
+    dst->m2 += src->m2 + delta * delta * na * nb / n;
+    dst->trials += src->trials;
+
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+    for (size_t k = 0; k <= dst->max_errors; k++)
+        dst->hist[k] += src->hist[k];
+    for (size_t i = 0; i < dst->n_pos; i++)
+        dst->heat[i] += src->heat[i];
+
+    dst->bursts += src->bursts;
+    dst->failed += src->failed;
+    dst->lost_symbols += src->lost_symbols;
+    dst->flips += src->flips;
+    return 0;
+}
+
+void error_stats_from_hist(ErrorStats *s)
+{
+    if (!s || s->trials == 0)
+        return;
+
+    // Dos pasadas centradas, siempre en el mismo orden de k
+    uint64_t sum = 0;
+    for (size_t k = 0; k <= s->max_errors; k++)
+        sum += (uint64_t)k * s->hist[k];
+    double mean = (double)sum / (double)s->trials;
+
+    double m2 = 0;
+    for (size_t k = 0; k <= s->max_errors; k++)
+    {
+        double d = (double)k - mean;
+        m2 += (double)s->hist[k] * d * d;
+    }
+    s->mean = mean;
+    s->m2 = m2;
+}
+
+double error_stats_stddev(const ErrorStats *s)
+{
+    return (s->trials > 0) ? sqrt(s->m2 / (double)s->trials) : 0;
+}
+
+int error_stats_percentile(const ErrorStats *s, double q)
+{
+    if (s->trials == 0)
+        return 0;
+    if (q > 1)
+        q = 1;
+
+    size_t rank = (size_t)ceil(q * (double)s->trials);
+    if (rank == 0)
+        rank = 1;
+
+    size_t acc = 0;
+    for (size_t k = 0; k <= s->max_errors; k++)
+    {
+        acc += s->hist[k];
+        if (acc >= rank)
+            return (int)k;
+    }
+    return (int)s->max_errors;
+}
+
+void error_stats_free(ErrorStats *s)
+{
+    if (!s)
+        return;
+    free(s->hist);
+    free(s->heat);
+    s->hist = NULL;
+    s->heat = NULL;
+}
+
+// ============================================
+// Barrido de ensayos por hilos
+// ============================================
+
+typedef struct
+{
+    const LineCodec *codec;
+    const char *bits;   // Mensaje original
+    const char *clean;  // Señal sin ruido (compartida, solo lectura)
+    size_t len, n_sym;
+    double ber;
+    uint64_t seed;
+    int begin, end;     // Ensayos [begin, end)
+    ErrorStats stats;   // Fragmento propio del hilo
+    int threaded;       // 1 si se lanzó un hilo para este rango
+} SweepRange;
+
+static void *sweep_worker(void *arg)
+{
+    SweepRange *r = arg;
+    ErrorStats *s = &r->stats;
+    char *noisy = safe_malloc(r->n_sym);
+    char *dec = safe_malloc(r->len + 1);
+    dec[r->len] = '\0';
+
+    for (int t = r->begin; t < r->end; t++)
+    {
+        Rng rng;
+        rng_seed(&rng, r->seed + (uint64_t)t);
+        memcpy(noisy, r->clean, r->n_sym);
+        s->flips += line_add_noise(r->codec, noisy, r->n_sym, r->ber, &rng);
+
+        LineState st;
+        line_state_init(&st);
+        int errors;
+        if (r->codec->decode_block(noisy, r->n_sym, dec, &st) == 0)
+        {
+            errors = (int)count_bit_errors(r->bits, dec);
+        }
+        else
+        {
+            // Misma convención que run_simulations: trama perdida = len errores
+            errors = (int)r->len;
+            s->failed++;
+            line_state_init(&st);
+            s->lost_symbols += line_decode_erasures(r->codec, noisy, r->n_sym, dec, &st);
+        }
+
+        error_stats_add(s, errors);
+        error_stats_add_positions(s, r->bits, dec);
+    }
+
+    free(noisy);
+    free(dec);
+    return NULL;
+}
+
+int error_sweep(const LineCodec *codec, const char *bitstream, double ber, int N, uint64_t seed,
+                unsigned nthreads, ErrorStats *out)
+{
+    if (!codec || !bitstream || !out || N <= 0)
+        return -1;
+
+    size_t len = strlen(bitstream);
+    if (len == 0 || len % codec->in_block != 0)
+    {
+        fprintf(stderr, "Error: longitud %zu no es múltiplo del bloque de %s\n", len, codec->name);
+        return -1;
+    }
+
+    size_t n_sym = len / codec->in_block * codec->out_block;
+    char *clean = safe_malloc(n_sym);
+    LineState st;
+    line_state_init(&st);
+    if (codec->encode_block(bitstream, len, clean, &st) != 0)
+    {
+        free(clean);
+        return -1;
+    }
+
+    if (nthreads == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (online > 0) ? (unsigned)online : 1;
+    }
+    if ((double)N * (double)n_sym < ERROR_SWEEP_MIN_SYMBOLS)
+        nthreads = 1;
+    if (nthreads > (unsigned)N)
+        nthreads = (unsigned)N;
+
+    SweepRange *ranges = safe_malloc(nthreads * sizeof(SweepRange));
+    pthread_t *tids = safe_malloc(nthreads * sizeof(pthread_t));
+    int status = 0;
+    unsigned used = 0;
+
+    for (unsigned t = 0; t < nthreads; t++, used++)
+    {
+        SweepRange *r = &ranges[t];
+        *r = (SweepRange){codec, bitstream, clean, len, n_sym, ber, seed,
+                          (int)((long long)N * t / nthreads), (int)((long long)N * (t + 1) / nthreads),
+                          {0}, 0};
+        if (error_stats_init(&r->stats, len, len) != 0)
+        {
+            status = -1;
+            break;
+        }
+        if (nthreads > 1)
+            r->threaded = (pthread_create(&tids[t], NULL, sweep_worker, r) == 0);
+        if (!r->threaded)
+            sweep_worker(r); // Sin hilo disponible: se procesa aquí
+    }
+
+    // Los fragmentos se combinan en orden de hilo: el resultado es determinista
+    if (status == 0)
+        status = error_stats_init(out, len, len);
+    for (unsigned t = 0; t < used; t++)
+    {
+        if (ranges[t].threaded)
+            pthread_join(tids[t], NULL);
+        if (status == 0)
+            error_stats_merge(out, &ranges[t].stats);
+        error_stats_free(&ranges[t].stats);
+    }
+    if (status == 0)
+        error_stats_from_hist(out);
+
+    free(ranges);
+    free(tids);
+    free(clean);
+    return status;
+}
+
+// ============================================
+// Reporte
+// ============================================
+
+/**
+ * Mapa de calor compacto: un dígito por tramo del mensaje (0 = tramo sin
+ * errores, 9 = tramo más afectado entre todos los esquemas del reporte).
+ */
+static void heat_strip(const ErrorStats *s, double scale, char *out)
+{
+    for (size_t b = 0; b < HEAT_STRIP; b++)
+    {
+        size_t from = s->n_pos * b / HEAT_STRIP, to = s->n_pos * (b + 1) / HEAT_STRIP;
+        size_t sum = 0;
+        for (size_t i = from; i < to; i++)
+            sum += s->heat[i];
+        double rate = (to > from) ? (double)sum / (double)(to - from) : 0;
+        int level = (scale > 0) ? (int)ceil(9.0 * rate / scale) : 0;
+        out[b] = (char)('0' + (level > 9 ? 9 : level));
+    }
+    out[HEAT_STRIP] = '\0';
+}
+
+static double heat_peak(const ErrorStats *s)
+{
+    double peak = 0;
+    for (size_t b = 0; b < HEAT_STRIP; b++)
+    {
+        size_t from = s->n_pos * b / HEAT_STRIP, to = s->n_pos * (b + 1) / HEAT_STRIP;
+        size_t sum = 0;
+        for (size_t i = from; i < to; i++)
+            sum += s->heat[i];
+        if (to > from && (double)sum / (double)(to - from) > peak)
+            peak = (double)sum / (double)(to - from);
+    }
+    return peak;
+}
+
+void report_error_stats_row(Report *report, const char *name, const ErrorStats *s)
+{
+    if (!report || !s)
+        return;
+    if (s->trials == 0)
+    {
+        report_row(report, 0, "%s\t-\t-\t-\t-\t-\t-\t-", name);
+        return;
+    }
+    report_row(report, 0, "%s\t%.2f\t%d\t%d\t%.2f\t%d\t%d\t%d", name, s->mean, s->min, s->max,
+               error_stats_stddev(s), error_stats_percentile(s, 0.5), error_stats_percentile(s, 0.99),
+               error_stats_percentile(s, 0.999));
+}
+
+void run_error_distribution(Report *report, const char *bitstream, double ber, int N, uint64_t seed)
+{
+    if (!report || !bitstream)
+        return;
+
+    size_t n_codecs;
+    const LineCodec *codecs = codec_registry(&n_codecs);
+    ErrorStats *stats = safe_malloc(n_codecs * sizeof(ErrorStats));
+    int *ok = safe_malloc(n_codecs * sizeof(int));
+    double scale = 0;
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        ok[c] = (error_sweep(&codecs[c], bitstream, ber, N, seed, 0, &stats[c]) == 0);
+        if (ok[c] && heat_peak(&stats[c]) > scale)
+            scale = heat_peak(&stats[c]);
+    }
+
+    report_printf(report, "\n### 11. Distribución de Errores por Ensayo (N=%d, BER=%.3f)\n", N, ber);
+    report_printf(report, "Percentiles del histograma de errores por ensayo. *Bits por inversión*: bits "
+                          "errados por cada símbolo invertido en el canal; *racha media*: bits errados "
+                          "consecutivos. El mapa divide el mensaje en %d tramos (0 = sin errores, 9 = el "
+                          "tramo más afectado de la tabla).\n\n",
+                  HEAT_STRIP);
+    report_table_begin(report, "Distribución de errores",
+                       "Esquema\tMedia\tDesv. Estándar\tp50\tp99\tp99.9\tTramas Perdidas\tSímbolos Perdidos"
+                       "\tBits por Inversión\tRacha Media\tMapa por Posición");
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        if (!ok[c])
+        {
+            report_row(report, 0, "%s\terror\t-\t-\t-\t-\t-\t-\t-\t-\t-", codecs[c].name);
+            continue;
+        }
+
+        const ErrorStats *s = &stats[c];
+        size_t wrong = 0;
+        for (size_t i = 0; i < s->n_pos; i++)
+            wrong += s->heat[i];
+
+        char strip[HEAT_STRIP + 1];
+        heat_strip(s, scale, strip);
+        report_row(report, 0, "%s\t%.2f\t%.2f\t%d\t%d\t%d\t%zu\t%zu\t%.2f\t%.2f\t`%s`", codecs[c].name, s->mean,
+                   error_stats_stddev(s), error_stats_percentile(s, 0.5), error_stats_percentile(s, 0.99),
+                   error_stats_percentile(s, 0.999), s->failed, s->lost_symbols,
+                   s->flips ? (double)wrong / (double)s->flips : 0, s->bursts ? (double)wrong / (double)s->bursts : 0,
+                   strip);
+        error_stats_free(&stats[c]);
+    }
+
+    free(stats);
+    free(ok);
+}
@@ -0,0 +1,124 @@
+#ifndef ERRSTATS_H
+#define ERRSTATS_H
+
+/**
+ * @file errstats.h
+ * @brief Distribución de errores por ensayo y mapa de errores por posición
+ *
+ * En lugar de reducir cada esquema a media/mínimo/máximo, se guarda el
+ * histograma completo de errores por ensayo (de ahí salen p50/p99/p99.9)
+ * y, por cada bit del mensaje, cuántos ensayos lo decodificaron mal.
+ *
+ * Cada hilo acumula en su propio ErrorStats sin candados; al terminar los
+ * acumuladores se combinan con la fórmula de Chan (media y M2 de Welford),
+ * que es estable aunque N sea grande, a diferencia de sum_sq/N - media².
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codec.h"
+#include "report.h"
+
+typedef struct
+{
+    size_t trials;     // Ensayos acumulados
+    double mean, m2;   // Welford: media y suma de cuadrados centrada
+    int min, max;
+    size_t max_errors; // hist tiene max_errors + 1 casillas
+    size_t *hist;      // hist[k]: ensayos con exactamente k bits errados
+    size_t n_pos;      // Longitud del mensaje (0: sin mapa por posición)
+    size_t *heat;      // heat[i]: ensayos en que el bit i llegó errado
+    size_t bursts;     // Rachas de bits errados consecutivos (en el mapa)
+    size_t failed;     // Ensayos en que la decodificación falló (cuentan len errores)
+    size_t lost_symbols; // Bloques de código inválidos (símbolos perdidos enteros)
+    size_t flips;      // Símbolos de línea invertidos por el canal
+} ErrorStats;
+
+/**
+ * @brief Prepara un acumulador vacío
+ * @param max_errors Mayor número de errores por ensayo (normalmente la longitud del mensaje)
+ * @param n_pos Posiciones del mapa de calor (0 para no llevarlo)
+ * @return 0 si tuvo éxito, -1 si hubo error
+ */
+int error_stats_init(ErrorStats *s, size_t max_errors, size_t n_pos);
+
+/**
+ * @brief Registra un ensayo con el número de bits errados indicado
+ */
+void error_stats_add(ErrorStats *s, int errors);
+
+/**
+ * @brief Suma al mapa de calor las posiciones en que dec difiere de orig
+ *
+ * También cuenta las rachas de errores consecutivos: su longitud media
+ * separa un error aislado (NRZ) de uno duplicado (NRZI) o de un símbolo
+ * perdido entero (4B/5B).
+ *
+ * @param dec Bits decodificados (n_pos caracteres)
+ */
+void error_stats_add_positions(ErrorStats *s, const char *orig, const char *dec);
+
+/**
+ * @brief Combina src dentro de dst (histograma, mapa y momentos por Chan)
+ * @return 0 si tuvo éxito, -1 si las dimensiones no coinciden
+ */
+int error_stats_merge(ErrorStats *dst, const ErrorStats *src);
+
+/**
+ * @brief Recalcula media y M2 a partir del histograma (exacto)
+ *
+ * La combinación de Chan depende del orden y del tamaño de los fragmentos
+ * en los últimos bits; el histograma no. Tras recalcular, los momentos solo
+ * dependen de qué ensayos se acumularon, no de cómo se repartieron entre
+ * hilos o bloques.
+ */
+void error_stats_from_hist(ErrorStats *s);
+
+/**
+ * @brief Desviación estándar poblacional de los errores por ensayo
+ */
+double error_stats_stddev(const ErrorStats *s);
+
+/**
+ * @brief Percentil por rango más cercano del histograma
+ * @param q Fracción en (0, 1] (0.5 para la mediana, 0.999 para p99.9)
+ * @return Menor k tal que al menos ceil(q·N) ensayos tuvieron <= k errores
+ */
+int error_stats_percentile(const ErrorStats *s, double q);
+
+void error_stats_free(ErrorStats *s);
+
+// Volumen mínimo (ensayos × símbolos) para repartir los ensayos entre hilos
+#define ERROR_SWEEP_MIN_SYMBOLS (1u << 20)
+
+/**
+ * @brief N ensayos de codificar + canal + decodificar con histograma y mapa
+ *
+ * El ensayo t usa su propio flujo (semilla seed + t) y los momentos se
+ * recalculan del histograma al final, así que el resultado no depende del
+ * número de hilos. Cuando un mensaje no decodifica, el mapa
+ * se llena bloque a bloque: solo se marcan los bits de los bloques inválidos.
+ *
+ * @param codec Esquema
+ * @param bitstream Mensaje (longitud múltiplo del bloque de entrada)
+ * @param ber Probabilidad de inversión por símbolo de línea
+ * @param N Número de ensayos
+ * @param seed Semilla base
+ * @param nthreads Hilos (0: tantos como núcleos)
+ * @param out Acumulador (se inicializa aquí; liberar con error_stats_free)
+ * @return 0 si tuvo éxito, -1 si hubo error
+ */
+int error_sweep(const LineCodec *codec, const char *bitstream, double ber, int N, uint64_t seed,
+                unsigned nthreads, ErrorStats *out);
+
+/**
+ * @brief Agrega una fila a la tabla "Errores por esquema" (media, extremos, desviación y percentiles)
+ */
+void report_error_stats_row(Report *report, const char *name, const ErrorStats *s);
+
+/**
+ * @brief Agrega al reporte percentiles y mapa de errores de todos los esquemas
+ */
+void run_error_distribution(Report *report, const char *bitstream, double ber, int N, uint64_t seed);
+
+#endif // ERRSTATS_H
@@ -0,0 +1,389 @@
+#include "fec.h"
+#include "blockcode.h"
+#include "codec.h"
+#include "rng.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Hamming(7,4)
+static uint8_t ham_enc[16];
+static uint8_t ham_dec[128]; // bits 0-3: nibble, bit 4: se corrigió un bit
+
+// SECDED(72,64): aporte de cada byte (bits 0-6: síndrome, bit 7: paridad)
+static uint8_t secded_tab[8][256];
+static int8_t secded_pos2bit[128]; // posición Hamming → bit de datos (-1 si no es dato)
+
+static pthread_once_t fec_once = PTHREAD_ONCE_INIT;
+
+static int is_power_of_two(unsigned x)
+{
+    return x && !(x & (x - 1));
+}
+
+static void fec_init(void)
+{
+    // Hamming(7,4): posiciones 1..7, paridades en 1, 2 y 4
+    static const unsigned data_pos[4] = {3, 5, 6, 7};
+    for (unsigned nib = 0; nib < 16; nib++)
+    {
+        unsigned bits[8] = {0};
+        for (int d = 0; d < 4; d++)
+            bits[data_pos[d]] = (nib >> (3 - d)) & 1;
+        for (unsigned p = 1; p <= 4; p <<= 1)
+            for (unsigned pos = 1; pos <= 7; pos++)
+                if ((pos & p) && pos != p)
+                    bits[p] ^= bits[pos];
+
+        uint8_t w = 0;
+        for (unsigned pos = 1; pos <= 7; pos++)
+            w |= (uint8_t)(bits[pos] << (7 - pos));
+        ham_enc[nib] = w;
+    }
+
+    for (unsigned w = 0; w < 128; w++)
+    {
+        unsigned syn = 0;
+        for (unsigned pos = 1; pos <= 7; pos++)
+            if ((w >> (7 - pos)) & 1)
+                syn ^= pos;
+
+        unsigned fixed = syn ? w ^ (1u << (7 - syn)) : w;
+        unsigned nib = 0;
+        for (int d = 0; d < 4; d++)
+            nib = (nib << 1) | ((fixed >> (7 - data_pos[d])) & 1);
+        ham_dec[w] = (uint8_t)(nib | (syn ? 0x10 : 0));
+    }
+
+    // SECDED: el bit de datos i (i = 63 es el primero) ocupa la i-ésima
+    // posición no potencia de 2 entre 3 y 71
+    unsigned data_bit_pos[64];
+    memset(secded_pos2bit, -1, sizeof(secded_pos2bit));
+    for (unsigned pos = 3, d = 0; d < 64; pos++)
+    {
+        if (is_power_of_two(pos))
+            continue;
+        unsigned bit = 63 - d;
+        data_bit_pos[bit] = pos;
+        secded_pos2bit[pos] = (int8_t)bit;
+        d++;
+    }
+
+    for (unsigned b = 0; b < 8; b++)
+    {
+        for (unsigned v = 0; v < 256; v++)
+        {
+            uint8_t acc = 0;
+            for (unsigned k = 0; k < 8; k++)
+            {
+                if ((v >> k) & 1)
+                    acc ^= (uint8_t)(data_bit_pos[8 * b + k] | 0x80);
+            }
+            secded_tab[b][v] = acc;
+        }
+    }
+}
+
+uint8_t hamming74_encode(unsigned nibble)
+{
+    pthread_once(&fec_once, fec_init);
+    return ham_enc[nibble & 0xF];
+}
+
+unsigned hamming74_decode(unsigned word, int *corrected)
+{
+    pthread_once(&fec_once, fec_init);
+    uint8_t e = ham_dec[word & 0x7F];
+    if (corrected)
+        *corrected = (e >> 4) & 1;
+    return e & 0xF;
+}
+
+/**
+ * Síndrome de 7 bits y paridad de los datos, combinando las 8 tablas
+ */
+static uint8_t secded_syndrome(uint64_t data)
+{
+    uint8_t acc = 0;
+    for (unsigned b = 0; b < 8; b++)
+        acc ^= secded_tab[b][(data >> (8 * b)) & 0xFF];
+    return acc;
+}
+
+static unsigned parity8(uint8_t x)
+{
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1;
+}
+
+uint8_t secded_encode(uint64_t data)
+{
+    pthread_once(&fec_once, fec_init);
+    uint8_t acc = secded_syndrome(data);
+    uint8_t c = acc & 0x7F;
+    unsigned overall = (acc >> 7) ^ parity8(c);
+    return (uint8_t)(c | (overall << 7));
+}
+
+int secded_decode(uint64_t *data, uint8_t check)
+{
+    pthread_once(&fec_once, fec_init);
+    uint8_t acc = secded_syndrome(*data);
+    unsigned syn = (acc ^ check) & 0x7F;
+    unsigned parity = (acc >> 7) ^ parity8(check & 0x7F) ^ (check >> 7);
+
+    if (syn == 0 && parity == 0)
+        return 0;
+    if (parity == 0)
+        return -1; // Síndrome sin error de paridad: dos errores
+
+    // Un error: en la paridad global (syn = 0), en un bit de control o en los datos
+    if (syn == 0 || is_power_of_two(syn))
+        return 1;
+    if (secded_pos2bit[syn] < 0)
+        return -1;
+
+    *data ^= 1ULL << secded_pos2bit[syn];
+    return 1;
+}
+
+size_t fec_encoded_length(FecCode code, size_t n_bits)
+{
+    switch (code)
+    {
+    case FEC_HAMMING74:
+        return (n_bits % 4 == 0) ? n_bits / 4 * 7 : 0;
+    case FEC_SECDED7264:
+        return (n_bits % 64 == 0) ? n_bits / 64 * 72 : 0;
+    }
+    return 0;
+}
+
+static uint64_t read_bits(const char *s, unsigned n)
+{
+    uint64_t v = 0;
+    for (unsigned i = 0; i < n; i++)
+        v = (v << 1) | (uint64_t)(s[i] == '1');
+    return v;
+}
+
+static void write_bits(char *s, uint64_t v, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++)
+        s[i] = (char)('0' + ((v >> (n - 1 - i)) & 1));
+}
+
+char *fec_encode(const char *bitstream, FecCode code)
+{
+    if (!is_valid_bitstream(bitstream))
+    {
+        fprintf(stderr, "Error: bitstream inválido en FEC\n");
+        return NULL;
+    }
+
+    size_t len = strlen(bitstream);
+    size_t out_len = fec_encoded_length(code, len);
+    if (out_len == 0 && len > 0)
+    {
+        fprintf(stderr, "Error: longitud %zu no es múltiplo del bloque FEC\n", len);
+        return NULL;
+    }
+
+    char *out = safe_malloc(out_len + 1);
+    char *p = out;
+
+    if (code == FEC_HAMMING74)
+    {
+        for (size_t i = 0; i < len; i += 4, p += 7)
+            write_bits(p, hamming74_encode((unsigned)read_bits(bitstream + i, 4)), 7);
+    }
+    else
+    {
+        for (size_t i = 0; i < len; i += 64, p += 72)
+        {
+            uint64_t data = read_bits(bitstream + i, 64);
+            memcpy(p, bitstream + i, 64);
+            write_bits(p + 64, secded_encode(data), 8);
+        }
+    }
+
+    out[out_len] = '\0';
+    return out;
+}
+
+char *fec_decode(const char *coded, FecCode code, FecStats *stats)
+{
+    if (!is_valid_bitstream(coded))
+    {
+        fprintf(stderr, "Error: señal inválida en FEC\n");
+        return NULL;
+    }
+
+    size_t len = strlen(coded);
+    unsigned n = (code == FEC_HAMMING74) ? 7 : 72;
+    unsigned k = (code == FEC_HAMMING74) ? 4 : 64;
+    if (len % n != 0)
+    {
+        fprintf(stderr, "Error: longitud %zu no es múltiplo de %u\n", len, n);
+        return NULL;
+    }
+
+    size_t blocks = len / n;
+    char *out = safe_malloc(blocks * k + 1);
+    FecStats local = {0};
+
+    for (size_t b = 0; b < blocks; b++)
+    {
+        const char *in = coded + b * n;
+        char *dst = out + b * k;
+
+        if (code == FEC_HAMMING74)
+        {
+            int corrected;
+            write_bits(dst, hamming74_decode((unsigned)read_bits(in, 7), &corrected), 4);
+            local.corrected += corrected;
+        }
+        else
+        {
+            uint64_t data = read_bits(in, 64);
+            int r = secded_decode(&data, (uint8_t)read_bits(in + 64, 8));
+            write_bits(dst, data, 64);
+            local.corrected += (r == 1);
+            local.uncorrectable += (r < 0);
+        }
+    }
+
+    if (stats)
+    {
+        stats->blocks += blocks;
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+
+    out[blocks * k] = '\0';
+    return out;
+}
+
+char *fec_line_decode(const LineCodec *codec, const char *symbols, size_t n_sym, FecCode code,
+                      FecStats *stats, size_t *erased)
+{
+    if (!codec || !symbols || n_sym % codec->out_block != 0)
+        return NULL;
+
+    size_t n_bits = n_sym / codec->out_block * codec->in_block;
+    char *rx = safe_malloc(n_bits + 1);
+    LineState st;
+    line_state_init(&st);
+    size_t lost = line_decode_erasures(codec, symbols, n_sym, rx, &st);
+    rx[n_bits] = '\0';
+    if (erased)
+        *erased = lost * codec->in_block;
+
+    // Valor fijo para las borraduras: la FEC las trata como un error más
+    for (size_t i = 0; i < n_bits; i++)
+        if (rx[i] == BLOCK_ERASURE)
+            rx[i] = '0';
+
+    char *data = fec_decode(rx, code, stats);
+    free(rx);
+    return data;
+}
+
+/**
+ * Errores medios por ensayo: FEC (opcional) → línea → canal → línea → FEC.
+ * Los bloques de línea inválidos cuentan como borraduras, no como trama perdida.
+ */
+static double fec_trial_mean(const LineCodec *codec, const char *bits, size_t len, int use_fec,
+                             FecCode code, double ber, int N, uint64_t seed, FecStats *stats)
+{
+    char *protected_bits = use_fec ? fec_encode(bits, code) : string_duplicate(bits);
+    size_t plen = strlen(protected_bits);
+    if (plen % codec->in_block != 0)
+    {
+        free(protected_bits);
+        return -1;
+    }
+
+    size_t n_sym = plen / codec->in_block * codec->out_block;
+    char *clean = safe_malloc(n_sym);
+    char *noisy = safe_malloc(n_sym);
+    char *rx = safe_malloc(plen);
+    LineState st;
+    line_state_init(&st);
+    codec->encode_block(protected_bits, plen, clean, &st);
+
+    Rng rng;
+    rng_seed(&rng, seed);
+    double sum = 0;
+
+    for (int t = 0; t < N; t++)
+    {
+        memcpy(noisy, clean, n_sym);
+        line_add_noise(codec, noisy, n_sym, ber, &rng);
+
+        char *data = rx;
+        if (use_fec)
+        {
+            data = fec_line_decode(codec, noisy, n_sym, code, stats, NULL);
+        }
+        else
+        {
+            line_state_init(&st);
+            line_decode_erasures(codec, noisy, n_sym, rx, &st);
+        }
+
+        // Un bit borrado cuenta como error
+        size_t errors = 0;
+        for (size_t i = 0; i < len; i++)
+            errors += (data[i] != bits[i]);
+        sum += (double)errors;
+        if (use_fec)
+            free(data);
+    }
+
+    free(protected_bits);
+    free(clean);
+    free(noisy);
+    free(rx);
+    return sum / N;
+}
+
+void run_fec_simulations(Report *report, const char *bitstream, double ber, int N)
+{
+    // Múltiplo de 64 bits: vale para ambos códigos y para 4B/5B
+    size_t len = strlen(bitstream) / 64 * 64;
+    if (!report || len == 0 || N <= 0)
+        return;
+
+    char *bits = safe_malloc(len + 1);
+    memcpy(bits, bitstream, len);
+    bits[len] = '\0';
+
+    size_t n_codecs;
+    const LineCodec *codecs = codec_registry(&n_codecs);
+
+    report_printf(report, "\n### 9. Corrección de Errores (FEC) + Esquema de Línea (N=%d, BER=%.3f)\n", N, ber);
+    report_printf(report, "Media de bits errados sobre %zu bits útiles. Los bloques de línea inválidos "
+                          "llegan a la FEC como borraduras (bit 0).\n\n",
+                  len);
+    report_table_begin(report, "Corrección de errores",
+                       "Esquema\tSin FEC\tHamming(7,4)\tCorregidos\tSECDED(72,64)\tCorregidos\tNo Corregibles");
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        FecStats ham = {0}, sec = {0};
+        uint64_t seed = 30532641u + c;
+        double bare = fec_trial_mean(&codecs[c], bits, len, 0, FEC_HAMMING74, ber, N, seed, NULL);
+        double h74 = fec_trial_mean(&codecs[c], bits, len, 1, FEC_HAMMING74, ber, N, seed, &ham);
+        double s72 = fec_trial_mean(&codecs[c], bits, len, 1, FEC_SECDED7264, ber, N, seed, &sec);
+
+        report_row(report, 0, "%s\t%.2f\t%.2f\t%zu\t%.2f\t%zu\t%zu", codecs[c].name, bare, h74,
+                   ham.corrected, s72, sec.corrected, sec.uncorrectable);
+    }
+
+    free(bits);
+}
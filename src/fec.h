@@ -0,0 +1,104 @@
+#ifndef FEC_H
+#define FEC_H
+
+/**
+ * @file fec.h
+ * @brief Corrección de errores (FEC) por tablas: Hamming(7,4) y SECDED(72,64)
+ *
+ * La etapa envuelve a cualquier esquema de encoding.h: los bits se protegen
+ * antes de la codificación de línea y se corrigen después de decodificar.
+ * Ambos códigos trabajan sobre palabras empaquetadas:
+ * - Hamming(7,4): tabla de 16 palabras código y tabla de síndromes de 128
+ *   entradas (corrige 1 error por bloque).
+ * - SECDED(72,64): Hamming extendido con 8 bits de control por palabra de
+ *   64 bits, calculados con 8 tablas de 256 entradas (una por byte).
+ *   Corrige 1 error y detecta 2.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codec.h"
+#include "report.h"
+
+typedef enum
+{
+    FEC_HAMMING74,
+    FEC_SECDED7264
+} FecCode;
+
+typedef struct
+{
+    size_t blocks;         // Bloques decodificados
+    size_t corrected;      // Bloques con un error corregido
+    size_t uncorrectable;  // Bloques con errores detectados no corregibles
+} FecStats;
+
+/**
+ * @brief Longitud protegida de un mensaje
+ * @return Bits tras la FEC, o 0 si n_bits no es múltiplo del bloque de datos
+ */
+size_t fec_encoded_length(FecCode code, size_t n_bits);
+
+/**
+ * @brief Palabra Hamming(7,4) de un nibble (p1 p2 d1 p3 d2 d3 d4, p1 en el bit 6)
+ */
+uint8_t hamming74_encode(unsigned nibble);
+
+/**
+ * @brief Decodifica una palabra Hamming(7,4)
+ * @param word Palabra recibida (7 bits)
+ * @param corrected Salida: 1 si se corrigió un bit
+ * @return Nibble de datos
+ */
+unsigned hamming74_decode(unsigned word, int *corrected);
+
+/**
+ * @brief Bits de control SECDED de una palabra de 64 bits
+ * @return 7 bits de paridad Hamming (bits 0-6) y paridad global (bit 7)
+ */
+uint8_t secded_encode(uint64_t data);
+
+/**
+ * @brief Verifica y corrige una palabra SECDED
+ * @param data Datos recibidos (se corrigen in-place)
+ * @param check Bits de control recibidos
+ * @return 0 sin errores, 1 si se corrigió un bit, -1 si no es corregible
+ */
+int secded_decode(uint64_t *data, uint8_t check);
+
+/**
+ * @brief Protege un bitstream con el código indicado
+ * @param bitstream Cadena de bits (múltiplo de 4 o de 64 bits)
+ * @return Cadena protegida (memoria dinámica, debe liberarse con free)
+ */
+char *fec_encode(const char *bitstream, FecCode code);
+
+/**
+ * @brief Corrige y extrae los datos de un bitstream protegido
+ * @param coded Cadena protegida
+ * @param stats Contadores a acumular (puede ser NULL)
+ * @return Bits de datos (memoria dinámica, debe liberarse con free)
+ */
+char *fec_decode(const char *coded, FecCode code, FecStats *stats);
+
+/**
+ * @brief Decodifica una señal de línea y corrige con FEC
+ *
+ * Un bloque de línea inválido no descarta la trama: sus bits salen como
+ * borraduras, que pasan a la FEC como bits en 0 y se corrigen como
+ * cualquier otro error.
+ *
+ * @param symbols Señal recibida (n_sym múltiplo de out_block)
+ * @param stats Contadores a acumular (puede ser NULL)
+ * @param erased Salida: bits borrados por la línea (puede ser NULL)
+ * @return Bits de datos (memoria dinámica, debe liberarse con free), o NULL si hubo error
+ */
+char *fec_line_decode(const LineCodec *codec, const char *symbols, size_t n_sym, FecCode code,
+                      FecStats *stats, size_t *erased);
+
+/**
+ * @brief Errores medios tras FEC + esquema de línea, para cada esquema registrado
+ */
+void run_fec_simulations(Report *report, const char *bitstream, double ber, int N);
+
+#endif // FEC_H
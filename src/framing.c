@@ -0,0 +1,197 @@
+#include "framing.h"
+#include "codec.h"
+#include "crc32.h"
+#include "rng.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+size_t framed_length(size_t n_bits, size_t frame_bits)
+{
+    if (frame_bits == 0)
+        return 0;
+    size_t frames = (n_bits + frame_bits - 1) / frame_bits;
+    return n_bits + frames * FRAME_CRC_BITS;
+}
+
+static uint32_t frame_crc(const char *data, size_t data_bits, uint8_t *scratch)
+{
+    size_t bytes = pack_bitstream(data, data_bits, scratch);
+    return crc32_compute(scratch, bytes);
+}
+
+char *frame_encode(const char *bitstream, size_t frame_bits)
+{
+    if (!is_valid_bitstream(bitstream) || frame_bits == 0)
+    {
+        fprintf(stderr, "Error: bitstream o tamaño de trama inválido\n");
+        return NULL;
+    }
+
+    size_t len = strlen(bitstream);
+    char *framed = safe_malloc(framed_length(len, frame_bits) + 1);
+    uint8_t *scratch = safe_malloc((frame_bits + 7) / 8);
+    size_t pos = 0;
+
+    for (size_t i = 0; i < len; i += frame_bits)
+    {
+        size_t n = (len - i < frame_bits) ? len - i : frame_bits;
+        uint32_t crc = frame_crc(bitstream + i, n, scratch);
+
+        memcpy(framed + pos, bitstream + i, n);
+        pos += n;
+        for (int b = FRAME_CRC_BITS - 1; b >= 0; b--)
+            framed[pos++] = (char)('0' + ((crc >> b) & 1));
+    }
+
+    framed[pos] = '\0';
+    free(scratch);
+    return framed;
+}
+
+static int frame_crc_ok_scratch(const char *frame, size_t data_bits, uint8_t *scratch)
+{
+    uint32_t rx = 0;
+    for (size_t b = 0; b < FRAME_CRC_BITS; b++)
+    {
+        char c = frame[data_bits + b];
+        if (c != '0' && c != '1')
+            return 0;
+        rx = (rx << 1) | (uint32_t)(c == '1');
+    }
+    return frame_crc(frame, data_bits, scratch) == rx;
+}
+
+int frame_crc_ok(const char *frame, size_t data_bits)
+{
+    if (!frame)
+        return 0;
+    uint8_t *scratch = safe_malloc((data_bits + 7) / 8 + 1);
+    int ok = frame_crc_ok_scratch(frame, data_bits, scratch);
+    free(scratch);
+    return ok;
+}
+
+static void frame_receive_scratch(const LineCodec *codec, const char *framed, const char *signal, size_t len,
+                                  size_t frame_bits, char *decoded, uint8_t *scratch, FrameStats *stats)
+{
+    LineState st;
+    line_state_init(&st);
+    size_t in_pos = 0, sym_pos = 0;
+
+    while (in_pos < len)
+    {
+        size_t data_bits = len - in_pos - FRAME_CRC_BITS;
+        if (data_bits > frame_bits)
+            data_bits = frame_bits;
+        size_t n = data_bits + FRAME_CRC_BITS;
+        size_t n_frame_sym = n / codec->in_block * codec->out_block;
+
+        LineState before = st;
+        int ok = (codec->decode_block(signal + sym_pos, n_frame_sym, decoded, &st) == 0);
+        int errored = !ok || memcmp(decoded, framed + in_pos, n) != 0;
+        int passed = ok && frame_crc_ok_scratch(decoded, data_bits, scratch);
+
+        stats->frames++;
+        stats->errored += errored;
+        stats->detected += !passed;
+        stats->undetected += errored && passed;
+
+        // El receptor sigue desde lo que realmente vio: el esquema deduce su estado
+        // de los símbolos recibidos (igual que line_decode_erasures)
+        if (!ok)
+        {
+            st = before;
+            if (codec->decode_state)
+                codec->decode_state(signal + sym_pos, n_frame_sym, &st);
+        }
+
+        in_pos += n;
+        sym_pos += n_frame_sym;
+    }
+}
+
+void frame_receive(const LineCodec *codec, const char *framed, const char *signal, size_t frame_bits,
+                   FrameStats *stats)
+{
+    if (!codec || !framed || !signal || !stats || frame_bits == 0)
+        return;
+    uint8_t *scratch = safe_malloc((frame_bits + 7) / 8 + 1);
+    char *decoded = safe_malloc(frame_bits + FRAME_CRC_BITS);
+    frame_receive_scratch(codec, framed, signal, strlen(framed), frame_bits, decoded, scratch, stats);
+    free(scratch);
+    free(decoded);
+}
+
+/**
+ * Una transmisión completa: ruido sobre la señal, decodificación y
+ * verificación trama por trama.
+ */
+static void frame_trial(const LineCodec *codec, const char *framed, const char *clean, char *noisy,
+                        char *decoded, size_t len, size_t frame_bits, double ber, Rng *rng,
+                        uint8_t *scratch, FrameStats *stats)
+{
+    size_t n_sym = len / codec->in_block * codec->out_block;
+    memcpy(noisy, clean, n_sym);
+
+    line_add_noise(codec, noisy, n_sym, ber, rng);
+    frame_receive_scratch(codec, framed, noisy, len, frame_bits, decoded, scratch, stats);
+}
+
+void run_framing_analysis(Report *report, const char *bitstream, double ber, int N,
+                          size_t frame_bits)
+{
+    char *framed = frame_encode(bitstream, frame_bits);
+    if (!report || !framed || N <= 0)
+    {
+        free(framed);
+        return;
+    }
+
+    size_t len = strlen(framed);
+    size_t n_codecs;
+    const LineCodec *codecs = codec_registry(&n_codecs);
+
+    report_printf(report, "\n### 8. Entramado con CRC-32 (tramas de %zu bits, N=%d, BER=%.3f)\n", frame_bits, N,
+                  ber);
+    report_printf(report, "CRC-32 %s.\n\n", crc32_has_clmul() ? "con plegado PCLMULQDQ" : "slice-by-8");
+    report_table_begin(report, "Entramado con CRC-32", "Esquema\tTramas\tFER\tDetectadas\tNo Detectadas");
+
+    uint8_t *scratch = safe_malloc((frame_bits + 7) / 8 + 1);
+    char *decoded = safe_malloc(frame_bits + FRAME_CRC_BITS);
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        const LineCodec *codec = &codecs[c];
+        if ((frame_bits % codec->in_block) != 0 || (len % codec->in_block) != 0)
+        {
+            report_row(report, 0, "%s\t-\t-\t-\t-", codec->name);
+            continue;
+        }
+
+        size_t n_sym = len / codec->in_block * codec->out_block;
+        char *clean = safe_malloc(n_sym);
+        char *noisy = safe_malloc(n_sym);
+        LineState st;
+        line_state_init(&st);
+        codec->encode_block(framed, len, clean, &st);
+
+        FrameStats stats = {0};
+        Rng rng;
+        rng_seed(&rng, 30532641u + c);
+        for (int t = 0; t < N; t++)
+            frame_trial(codec, framed, clean, noisy, decoded, len, frame_bits, ber, &rng, scratch, &stats);
+
+        report_row(report, 0, "%s\t%zu\t%.4f\t%.4f\t%.2e", codec->name, stats.frames,
+                   (double)stats.errored / stats.frames, (double)stats.detected / stats.frames,
+                   (double)stats.undetected / stats.frames);
+
+        free(clean);
+        free(noisy);
+    }
+
+    free(scratch);
+    free(decoded);
+    free(framed);
+}
@@ -0,0 +1,75 @@
+#ifndef FRAMING_H
+#define FRAMING_H
+
+/**
+ * @file framing.h
+ * @brief Entramado con CRC-32 para medir tramas erradas y no detectadas
+ *
+ * El mensaje se divide en tramas de `frame_bits` bits (la última puede ser
+ * más corta) y a cada una se le agregan 32 bits de CRC-32 calculado sobre
+ * sus bits empaquetados. En recepción, una trama es:
+ * - errada: algún bit (datos o CRC) difiere de lo transmitido
+ * - detectada: el CRC recalculado no coincide
+ * - no detectada: errada pero con CRC válido
+ */
+
+#include <stddef.h>
+#include "codec.h"
+#include "report.h"
+
+#define FRAME_CRC_BITS 32
+
+typedef struct
+{
+    size_t frames;      // Tramas recibidas
+    size_t errored;     // Tramas con algún bit errado
+    size_t detected;    // Tramas rechazadas por el CRC (o por el decodificador)
+    size_t undetected;  // Tramas erradas que pasaron el CRC
+} FrameStats;
+
+/**
+ * @brief Longitud total entramada (datos + CRC de cada trama)
+ */
+size_t framed_length(size_t n_bits, size_t frame_bits);
+
+/**
+ * @brief Divide el mensaje en tramas y agrega el CRC-32 de cada una
+ * @param bitstream Cadena de bits ('0' y '1')
+ * @param frame_bits Bits de datos por trama
+ * @return Cadena entramada (memoria dinámica, debe liberarse con free)
+ */
+char *frame_encode(const char *bitstream, size_t frame_bits);
+
+/**
+ * @brief Verifica una trama recibida contra su CRC
+ * @param frame Bits de datos seguidos de 32 bits de CRC
+ * @param data_bits Bits de datos de la trama
+ * @return 1 si el CRC coincide, 0 si no
+ */
+int frame_crc_ok(const char *frame, size_t data_bits);
+
+/**
+ * @brief Decodifica una señal entramada trama por trama y acumula el resultado
+ *
+ * Tras una trama que no decodifica, el estado de línea se deduce de los
+ * símbolos recibidos en ella (decode_state del esquema) para que la trama
+ * siguiente parta de la referencia correcta.
+ *
+ * @param framed Tramas enviadas (salida de frame_encode)
+ * @param signal Señal de línea recibida para todo framed
+ * @param frame_bits Bits de datos por trama (el mismo de frame_encode)
+ * @param stats Contadores a acumular
+ */
+void frame_receive(const LineCodec *codec, const char *framed, const char *signal, size_t frame_bits,
+                   FrameStats *stats);
+
+/**
+ * @brief Simula N transmisiones entramadas por cada esquema registrado
+ *
+ * Cada trama se decodifica por separado, de modo que un símbolo inválido
+ * solo invalida su trama. Agrega al reporte FER y tasa de no detectadas.
+ */
+void run_framing_analysis(Report *report, const char *bitstream, double ber, int N,
+                          size_t frame_bits);
+
+#endif // FRAMING_H
@@ -0,0 +1,51 @@
+#ifndef IMPORTANCE_H
+#define IMPORTANCE_H
+
+/**
+ * @file importance.h
+ * @brief Estimación de BER muy bajos por muestreo de importancia
+ *
+ * El canal invierte símbolos con una probabilidad sesgada q > p. Cada ensayo
+ * con k inversiones sobre n símbolos se pondera con la razón de verosimilitud
+ * w = (p/q)^k · ((1-p)/(1-q))^(n-k), de modo que la media ponderada es un
+ * estimador insesgado de la tasa de error bajo el BER real p.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codec.h"
+#include "report.h"
+
+// Inversiones esperadas por trama cuando se elige q automáticamente
+#define IS_TARGET_FLIPS 1.0
+
+typedef struct
+{
+    double estimate;        // BER tras decodificar (bits errados / bit útil)
+    double variance;        // Varianza del estimador
+    double frame_error;     // Probabilidad de trama con algún bit errado
+    double frame_variance;  // Varianza de frame_error
+    double biased_ber;      // q usado para generar el ruido
+    int trials;
+} ISResult;
+
+/**
+ * @brief Estima la tasa de error tras decodificar con muestreo de importancia
+ * @param codec Esquema a simular
+ * @param bitstream Mensaje fijo (longitud múltiplo del bloque del esquema)
+ * @param ber BER real del canal (p)
+ * @param biased_ber Probabilidad sesgada q (<= 0 para elegirla automáticamente)
+ * @param N Número de ensayos
+ * @param seed Semilla del ruido
+ * @param out Resultado
+ * @return 0 si tuvo éxito, -1 si la entrada no es válida
+ */
+int importance_estimate(const LineCodec *codec, const char *bitstream, double ber, double biased_ber,
+                        int N, uint64_t seed, ISResult *out);
+
+/**
+ * @brief Curva BER de canal vs BER decodificado (1e-3 a 1e-12) para todos los esquemas
+ */
+void run_importance_sampling_curve(Report *report, const char *bitstream, int N);
+
+#endif // IMPORTANCE_H
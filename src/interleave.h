@@ -0,0 +1,108 @@
+#ifndef INTERLEAVE_H
+#define INTERLEAVE_H
+
+/**
+ * @file interleave.h
+ * @brief Entrelazadores de bloque y convolucional (etapa entre codificador y canal)
+ *
+ * Ambos trabajan por trozos: el estado (bloque parcial o líneas de retardo)
+ * vive en el contexto, así que un flujo puede entrelazarse en pedazos de
+ * cualquier tamaño con el mismo resultado que de una sola vez.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "report.h"
+
+// ============================================
+// Entrelazador de bloque (filas × columnas)
+// ============================================
+
+typedef struct
+{
+    size_t rows, cols;
+    int inverse;     // 0: entrelaza (escribe por filas, lee por columnas); 1: deshace
+    char *pending;   // Bloque parcial entre llamadas
+    size_t fill;
+} BlockInterleaver;
+
+/**
+ * @brief Inicializa un entrelazador de bloque
+ * @param inverse 0 para entrelazar, 1 para desentrelazar
+ * @return 0 si tuvo éxito, -1 si las dimensiones no son válidas
+ */
+int block_interleaver_init(BlockInterleaver *bi, size_t rows, size_t cols, int inverse);
+
+/**
+ * @brief Procesa un trozo; solo se emiten bloques completos
+ * @param out Buffer con espacio para fill + len símbolos
+ * @return Símbolos escritos en out
+ */
+size_t block_interleaver_push(BlockInterleaver *bi, const char *in, size_t len, char *out);
+
+/**
+ * @brief Emite el bloque parcial final sin permutar
+ * @return Símbolos escritos en out
+ */
+size_t block_interleaver_flush(BlockInterleaver *bi, char *out);
+
+void block_interleaver_free(BlockInterleaver *bi);
+
+/**
+ * @brief Transpuesta por bloques de una matriz de rows × cols símbolos
+ */
+void transpose_symbols(const char *in, char *out, size_t rows, size_t cols);
+
+/**
+ * @brief Transpuesta de una matriz de bits empaquetados (primer bit en el MSB)
+ *
+ * Cada fila ocupa cols/8 bytes; rows y cols deben ser múltiplos de 8. Se
+ * procesa por teselas de 8×8 bits transpuestas dentro de un uint64_t.
+ */
+void transpose_bits(const uint8_t *in, uint8_t *out, size_t rows, size_t cols);
+
+// ============================================
+// Entrelazador convolucional (Forney)
+// ============================================
+
+typedef struct
+{
+    size_t branches;  // Ramas B
+    size_t depth;     // Incremento de retardo M entre ramas
+    int inverse;
+    char *fifo;       // Todas las líneas de retardo contiguas
+    size_t *offset;   // Inicio de la línea de cada rama
+    size_t *head;     // Posición de lectura de cada rama
+    size_t branch;    // Rama que recibe el siguiente símbolo
+} ConvInterleaver;
+
+/**
+ * @brief Inicializa un entrelazador convolucional
+ *
+ * La rama j retrasa j·M símbolos (B-1-j en el desentrelazador), de modo que
+ * el par introduce un retardo total de B·(B-1)·M símbolos.
+ *
+ * @param fill Símbolo con el que arrancan las líneas de retardo
+ * @return 0 si tuvo éxito, -1 si los parámetros no son válidos
+ */
+int conv_interleaver_init(ConvInterleaver *ci, size_t branches, size_t depth, int inverse, char fill);
+
+/**
+ * @brief Procesa un trozo (un símbolo de salida por cada símbolo de entrada)
+ */
+void conv_interleaver_push(ConvInterleaver *ci, const char *in, size_t len, char *out);
+
+/**
+ * @brief Retardo total del par entrelazador/desentrelazador
+ */
+size_t conv_interleaver_delay(size_t branches, size_t depth);
+
+void conv_interleaver_free(ConvInterleaver *ci);
+
+/**
+ * @brief Errores tras Hamming(7,4) + esquema de línea ante ráfagas, con y sin entrelazado
+ */
+void run_interleaver_analysis(Report *report, const char *bitstream, double burst_prob,
+                              size_t burst_len, int N);
+
+#endif // INTERLEAVE_H
@@ -0,0 +1,179 @@
+#define _POSIX_C_SOURCE 200809L
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Trozos por hilo: más de uno reparte mejor si algún hilo se retrasa
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+typedef struct
+{
+    line_block_fn fn;
+    line_state_fn state_fn;
+    const char *in;
+    char *out;
+    size_t in_len;
+    size_t out_pos;
+    int start;      // Estado inicial (fase 2)
+    int end_from0;  // Estado final partiendo de 0 (fase 1)
+    int end_from1;  // Estado final partiendo de 1 (fase 1)
+    int status;
+} Chunk;
+
+typedef struct
+{
+    Chunk *chunks;
+    size_t begin, end;
+    int phase;      // 1: resumir estado, 3: codificar
+    int threaded;
+} ChunkRange;
+
+static void *chunk_worker(void *arg)
+{
+    ChunkRange *r = arg;
+
+    for (size_t i = r->begin; i < r->end; i++)
+    {
+        Chunk *c = &r->chunks[i];
+        if (r->phase == 1)
+        {
+            LineState st = {0};
+            c->state_fn(c->in, c->in_len, &st);
+            c->end_from0 = st.level;
+            st.level = 1;
+            c->state_fn(c->in, c->in_len, &st);
+            c->end_from1 = st.level;
+        }
+        else
+        {
+            LineState st = {c->start};
+            c->status = c->fn(c->in, c->in_len, c->out + c->out_pos, &st);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Ejecuta una fase sobre todos los trozos repartidos en `nthreads` rangos
+ */
+static void run_phase(Chunk *chunks, size_t count, unsigned nthreads, int phase,
+                      ChunkRange *ranges, pthread_t *tids)
+{
+    size_t per_thread = (count + nthreads - 1) / nthreads;
+    unsigned used = 0;
+
+    for (size_t begin = 0; begin < count; begin += per_thread, used++)
+    {
+        ChunkRange *r = &ranges[used];
+        r->chunks = chunks;
+        r->begin = begin;
+        r->end = (begin + per_thread < count) ? begin + per_thread : count;
+        r->phase = phase;
+        r->threaded = (pthread_create(&tids[used], NULL, chunk_worker, r) == 0);
+        if (!r->threaded)
+            chunk_worker(r); // Sin hilo disponible: se procesa aquí
+    }
+
+    for (unsigned t = 0; t < used; t++)
+        if (ranges[t].threaded)
+            pthread_join(tids[t], NULL);
+}
+
+static int parallel_run(const LineCodec *codec, const char *in, size_t len, char *out,
+                        unsigned nthreads, int decode)
+{
+    if (!codec || (!in && len > 0) || (!out && len > 0))
+        return -1;
+
+    unsigned in_block = decode ? codec->out_block : codec->in_block;
+    unsigned out_block = decode ? codec->in_block : codec->out_block;
+    line_block_fn fn = decode ? codec->decode_block : codec->encode_block;
+    line_state_fn state_fn = decode ? codec->decode_state : codec->encode_state;
+
+    if (len % in_block != 0)
+    {
+        fprintf(stderr, "Error: longitud %zu no es múltiplo de %u (%s)\n", len, in_block, codec->name);
+        return -1;
+    }
+
+    if (nthreads == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (online > 0) ? (unsigned)online : 1;
+    }
+
+    size_t blocks = len / in_block;
+    size_t count = (size_t)nthreads * PARALLEL_CHUNKS_PER_THREAD;
+    if (len < PARALLEL_MIN_BYTES || nthreads <= 1)
+        count = 1;
+    if (count > blocks)
+        count = blocks ? blocks : 1;
+
+    if (count == 1)
+    {
+        LineState st;
+        line_state_init(&st);
+        return fn(in, len, out, &st);
+    }
+
+    Chunk *chunks = malloc(count * sizeof(Chunk));
+    ChunkRange *ranges = malloc(nthreads * sizeof(ChunkRange));
+    pthread_t *tids = malloc(nthreads * sizeof(pthread_t));
+    if (!chunks || !ranges || !tids)
+    {
+        free(chunks);
+        free(ranges);
+        free(tids);
+        LineState st;
+        line_state_init(&st);
+        return fn(in, len, out, &st);
+    }
+
+    // Trozos alineados al bloque del esquema (4B/5B: 4 bits / 5 símbolos)
+    size_t per_chunk = blocks / count, extra = blocks % count, pos = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t nb = per_chunk + (i < extra ? 1 : 0);
+        chunks[i] = (Chunk){fn, state_fn, in + pos * in_block, out, nb * in_block, pos * out_block, 0, 0, 1, 0};
+        pos += nb;
+    }
+
+    // Fase 1: cada trozo resume su efecto sobre el estado (solo esquemas con memoria)
+    if (state_fn)
+        run_phase(chunks, count, nthreads, 1, ranges, tids);
+
+    // Fase 2: barrido exclusivo de las funciones de transición (secuencial, O(trozos))
+    LineState st;
+    line_state_init(&st);
+    for (size_t i = 0; i < count; i++)
+    {
+        chunks[i].start = st.level;
+        if (state_fn)
+            st.level = st.level ? chunks[i].end_from1 : chunks[i].end_from0;
+    }
+
+    // Fase 3: todos los trozos se codifican a la vez con su estado inicial
+    run_phase(chunks, count, nthreads, 3, ranges, tids);
+
+    int status = 0;
+    for (size_t i = 0; i < count; i++)
+        if (chunks[i].status != 0)
+            status = -1;
+
+    free(chunks);
+    free(ranges);
+    free(tids);
+    return status;
+}
+
+int parallel_encode(const LineCodec *codec, const char *in, size_t len, char *out, unsigned nthreads)
+{
+    return parallel_run(codec, in, len, out, nthreads, 0);
+}
+
+int parallel_decode(const LineCodec *codec, const char *in, size_t len, char *out, unsigned nthreads)
+{
+    return parallel_run(codec, in, len, out, nthreads, 1);
+}
@@ -0,0 +1,39 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * @file parallel.h
+ * @brief Codificación/decodificación de UN flujo grande repartido entre hilos
+ *
+ * Los esquemas con memoria (NRZI, AMI, ...) no se pueden cortar sin más:
+ * cada trozo depende del estado de línea al final del anterior. El estado
+ * es de un bit, así que cada hilo resume su trozo como la función
+ * f(estado inicial) → estado final (dos pasadas baratas de paridad); un
+ * barrido secuencial de esas funciones da el estado inicial de cada trozo
+ * y luego todos los trozos se codifican a la vez con el núcleo normal.
+ * El resultado es idéntico al de la versión secuencial.
+ */
+
+#include <stddef.h>
+#include "codec.h"
+
+// Por debajo de este volumen de entrada (bytes) el flujo se procesa en un hilo
+#define PARALLEL_MIN_BYTES (1u << 20)
+
+/**
+ * @brief Codifica un flujo usando varios hilos
+ * @param codec Esquema a usar
+ * @param in Bits de entrada (sin '\0' necesario)
+ * @param len Longitud de la entrada (múltiplo de codec->in_block)
+ * @param out Salida: len / in_block * out_block símbolos (sin '\0')
+ * @param nthreads Hilos a usar (0 = automático, 1 = secuencial)
+ * @return 0 si tuvo éxito, -1 si la entrada no es válida
+ */
+int parallel_encode(const LineCodec *codec, const char *in, size_t len, char *out, unsigned nthreads);
+
+/**
+ * @brief Decodifica un flujo usando varios hilos (mismos parámetros, en sentido inverso)
+ */
+int parallel_decode(const LineCodec *codec, const char *in, size_t len, char *out, unsigned nthreads);
+
+#endif // PARALLEL_H
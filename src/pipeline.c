@@ -0,0 +1,822 @@
+#define _POSIX_C_SOURCE 200809L
+#include "pipeline.h"
+#include "bitpack.h"
+#include "rng.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+// Cabecera del trozo redondeada para que data quede alineado
+#define PIPE_HEADER ((sizeof(PipeChunk) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+// Buffers que el pool reserva juntos
+#define PIPE_POOL_SLAB 8
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// ============================================
+// Trozos
+// ============================================
+
+PipeChunk *pipe_chunk_new(Pipeline *p)
+{
+    char *buf = pool_get(&p->pool);
+    PipeChunk *c = (PipeChunk *)buf;
+    atomic_init(&c->refs, 1);
+    c->origin = NULL;
+    c->pipe = p;
+    c->seq = 0;
+    c->len = 0;
+    c->data = buf + PIPE_HEADER;
+    return c;
+}
+
+void pipe_chunk_retain(PipeChunk *c)
+{
+    atomic_fetch_add_explicit(&c->refs, 1, memory_order_relaxed);
+}
+
+void pipe_chunk_release(PipeChunk *c)
+{
+    while (c && atomic_fetch_sub_explicit(&c->refs, 1, memory_order_acq_rel) == 1)
+    {
+        PipeChunk *origin = c->origin;
+        pool_put(&c->pipe->pool, c);
+        c = origin;
+    }
+}
+
+const PipeChunk *pipe_chunk_origin(const PipeChunk *c)
+{
+    return c->origin ? c->origin : c;
+}
+
+PipeChunk *pipe_chunk_derive(PipeChunk *in)
+{
+    Pipeline *p = in->pipe;
+    PipeChunk *n = pipe_chunk_new(p);
+    n->seq = in->seq;
+
+    // Un trozo de la fuente pasa a ser el origen de lo que se derive de él
+    PipeChunk *origin = in->origin ? in->origin : (p->track_origin ? in : NULL);
+    if (origin)
+        pipe_chunk_retain(origin);
+    n->origin = origin;
+    return n;
+}
+
+PipeChunk *pipe_chunk_writable(PipeChunk *c)
+{
+    int keep_source = (c->origin == NULL && c->pipe->track_origin);
+    if (atomic_load_explicit(&c->refs, memory_order_acquire) == 1 && !keep_source)
+        return c;
+
+    // Compartido (o son los bits enviados): copia en escritura
+    PipeChunk *n = pipe_chunk_derive(c);
+    memcpy(n->data, c->data, c->len);
+    n->len = c->len;
+    pipe_chunk_release(c);
+    return n;
+}
+
+// ============================================
+// Construcción
+// ============================================
+
+Pipeline *pipeline_create(size_t chunk_bits)
+{
+    if (chunk_bits == 0)
+        return NULL;
+    Pipeline *p = safe_malloc(sizeof(Pipeline));
+    memset(p, 0, sizeof(*p));
+    p->chunk_bits = chunk_bits;
+    atomic_init(&p->failed, 0);
+    return p;
+}
+
+void pipeline_fail(Pipeline *p)
+{
+    atomic_store(&p->failed, 1);
+}
+
+int pipeline_add_stage(Pipeline *p, const char *name, pipe_stage_fn fn, void *ctx, unsigned in_block,
+                       unsigned out_block)
+{
+    if (!p || !fn || p->n_stages == PIPE_MAX_STAGES || p->pool_ready)
+    {
+        free(ctx);
+        return -1;
+    }
+
+    int sink = (p->n_stages > 0 && out_block == 0);
+    if (p->n_stages == 0)
+    {
+        // La primera etapa es la fuente
+        p->cur_len = p->chunk_cap = p->chunk_bits;
+    }
+    else if (p->stages[p->n_stages - 1].sink && !sink)
+    {
+        fprintf(stderr, "Error: la etapa %s va después de un sumidero\n", name);
+        free(ctx);
+        return -1;
+    }
+    else if (!sink)
+    {
+        if (in_block == 0 || p->cur_len % in_block != 0)
+        {
+            fprintf(stderr, "Error: trozos de %zu símbolos no son múltiplo del bloque de %s\n", p->cur_len, name);
+            free(ctx);
+            return -1;
+        }
+        p->cur_len = p->cur_len / in_block * out_block;
+        if (p->cur_len > p->chunk_cap)
+            p->chunk_cap = p->cur_len;
+    }
+
+    PipeStage *s = &p->stages[p->n_stages++];
+    memset(s, 0, sizeof(*s));
+    s->name = name;
+    s->process = fn;
+    s->ctx = ctx;
+    s->sink = sink;
+    s->pipe = p;
+    return 0;
+}
+
+// ============================================
+// Etapas
+// ============================================
+
+typedef struct
+{
+    Rng rng;
+    uint64_t remaining;
+    uint64_t seq;
+} SourceCtx;
+
+static PipeChunk *source_stage(PipeStage *stage, PipeChunk *in)
+{
+    (void)in;
+    SourceCtx *ctx = stage->ctx;
+    Pipeline *p = stage->pipe;
+    if (ctx->remaining == 0 || atomic_load(&p->failed))
+        return NULL;
+
+    size_t n = (ctx->remaining < p->chunk_bits) ? (size_t)ctx->remaining : p->chunk_bits;
+    PipeChunk *c = pipe_chunk_new(p);
+    for (size_t i = 0; i < n; i += 64)
+    {
+        uint64_t w = rng_next(&ctx->rng);
+        uint8_t bytes[8];
+        for (int k = 0; k < 8; k++)
+            bytes[k] = (uint8_t)(w >> (56 - 8 * k));
+        bits_unpack(bytes, (n - i < 64) ? n - i : 64, c->data + i, '0', '1');
+    }
+    c->len = n;
+    c->seq = ctx->seq++;
+    ctx->remaining -= n;
+    return c;
+}
+
+int pipeline_add_source(Pipeline *p, uint64_t total_bits, uint64_t seed)
+{
+    if (!p || p->n_stages != 0)
+        return -1;
+    SourceCtx *ctx = safe_malloc(sizeof(SourceCtx));
+    rng_seed(&ctx->rng, seed);
+    ctx->remaining = total_bits;
+    ctx->seq = 0;
+    return pipeline_add_stage(p, "Fuente", source_stage, ctx, 1, 1);
+}
+
+// Período del aleatorizador x^7 + x^4 + 1
+#define SCRAMBLER_PERIOD 127
+
+typedef struct
+{
+    uint8_t seq[SCRAMBLER_PERIOD]; // Secuencia del registro (un período)
+    unsigned pos;
+} ScramblerCtx;
+
+static PipeChunk *scrambler_stage(PipeStage *stage, PipeChunk *in)
+{
+    ScramblerCtx *ctx = stage->ctx;
+    PipeChunk *c = pipe_chunk_writable(in);
+    unsigned pos = ctx->pos;
+
+    for (size_t i = 0; i < c->len; i++)
+    {
+        // Solo '0'/'1': las borraduras se conservan
+        if ((c->data[i] | 1) == '1')
+            c->data[i] ^= ctx->seq[pos];
+        if (++pos == SCRAMBLER_PERIOD)
+            pos = 0;
+    }
+    ctx->pos = pos;
+    return c;
+}
+
+int pipeline_add_scrambler(Pipeline *p, unsigned seed)
+{
+    if (!p || (seed & 0x7F) == 0)
+        return -1;
+    ScramblerCtx *ctx = safe_malloc(sizeof(ScramblerCtx));
+    unsigned s = seed & 0x7F;
+    for (unsigned i = 0; i < SCRAMBLER_PERIOD; i++)
+    {
+        unsigned fb = ((s >> 6) ^ (s >> 3)) & 1;
+        s = ((s << 1) | fb) & 0x7F;
+        ctx->seq[i] = (uint8_t)fb;
+    }
+    ctx->pos = 0;
+    return pipeline_add_stage(p, "Aleatorizador", scrambler_stage, ctx, 1, 1);
+}
+
+typedef struct
+{
+    const BlockCode *code;
+    BlockCodeStats stats;
+} BlockCtx;
+
+static PipeChunk *block_encoder_stage(PipeStage *stage, PipeChunk *in)
+{
+    BlockCtx *ctx = stage->ctx;
+    const BlockCode *bc = ctx->code;
+    PipeChunk *out = pipe_chunk_derive(in);
+    int ok = (in->len % bc->m == 0) && block_code_encode(bc, in->data, in->len, out->data) == 0;
+    out->len = in->len / bc->m * bc->n;
+    pipe_chunk_release(in);
+    if (!ok)
+    {
+        pipeline_fail(stage->pipe);
+        pipe_chunk_release(out);
+        return NULL;
+    }
+    return out;
+}
+
+static PipeChunk *block_decoder_stage(PipeStage *stage, PipeChunk *in)
+{
+    BlockCtx *ctx = stage->ctx;
+    const BlockCode *bc = ctx->code;
+    PipeChunk *out = pipe_chunk_derive(in);
+    int ok = (in->len % bc->n == 0) &&
+             block_code_decode_erasures(bc, in->data, in->len, out->data, &ctx->stats) == 0;
+    out->len = in->len / bc->n * bc->m;
+    pipe_chunk_release(in);
+    if (!ok)
+    {
+        pipeline_fail(stage->pipe);
+        pipe_chunk_release(out);
+        return NULL;
+    }
+    return out;
+}
+
+int pipeline_add_block_encoder(Pipeline *p, const BlockCode *code)
+{
+    if (!p || !code)
+        return -1;
+    BlockCtx *ctx = safe_malloc(sizeof(BlockCtx));
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->code = code;
+    return pipeline_add_stage(p, code->name, block_encoder_stage, ctx, code->m, code->n);
+}
+
+int pipeline_add_block_decoder(Pipeline *p, const BlockCode *code)
+{
+    if (!p || !code)
+        return -1;
+    BlockCtx *ctx = safe_malloc(sizeof(BlockCtx));
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->code = code;
+    return pipeline_add_stage(p, code->name, block_decoder_stage, ctx, code->n, code->m);
+}
+
+typedef struct
+{
+    const LineCodec *codec;
+    LineState st;
+    uint64_t lost;    // Bloques de línea inválidos (decodificador)
+} LineCtx;
+
+/**
+ * Los núcleos de un símbolo por bit leen in[i] antes de escribir out[i],
+ * así que con in_block == out_block se pueden usar en su lugar.
+ */
+static PipeChunk *line_encoder_stage(PipeStage *stage, PipeChunk *in)
+{
+    LineCtx *ctx = stage->ctx;
+    const LineCodec *codec = ctx->codec;
+    if (in->len % codec->in_block != 0)
+    {
+        pipeline_fail(stage->pipe);
+        pipe_chunk_release(in);
+        return NULL;
+    }
+
+    PipeChunk *out;
+    int status;
+    if (codec->in_block == codec->out_block)
+    {
+        out = pipe_chunk_writable(in);
+        status = codec->encode_block(out->data, out->len, out->data, &ctx->st);
+    }
+    else
+    {
+        out = pipe_chunk_derive(in);
+        out->len = in->len / codec->in_block * codec->out_block;
+        status = codec->encode_block(in->data, in->len, out->data, &ctx->st);
+        pipe_chunk_release(in);
+    }
+
+    if (status != 0)
+    {
+        pipeline_fail(stage->pipe);
+        pipe_chunk_release(out);
+        return NULL;
+    }
+    return out;
+}
+
+static PipeChunk *line_decoder_stage(PipeStage *stage, PipeChunk *in)
+{
+    LineCtx *ctx = stage->ctx;
+    const LineCodec *codec = ctx->codec;
+    if (in->len % codec->out_block != 0)
+    {
+        pipeline_fail(stage->pipe);
+        pipe_chunk_release(in);
+        return NULL;
+    }
+
+    LineState before = ctx->st;
+    if (codec->in_block == codec->out_block)
+    {
+        // En su lugar solo fallan símbolos ajenos al alfabeto (el canal no los produce):
+        // el trozo entero se marca como borrado
+        PipeChunk *out = pipe_chunk_writable(in);
+        if (codec->decode_block(out->data, out->len, out->data, &ctx->st) != 0)
+        {
+            memset(out->data, BLOCK_ERASURE, out->len);
+            ctx->st = before;
+            ctx->lost += out->len / codec->out_block;
+        }
+        return out;
+    }
+
+    PipeChunk *out = pipe_chunk_derive(in);
+    out->len = in->len / codec->out_block * codec->in_block;
+    if (codec->decode_block(in->data, in->len, out->data, &ctx->st) != 0)
+    {
+        ctx->st = before;
+        ctx->lost += line_decode_erasures(codec, in->data, in->len, out->data, &ctx->st);
+    }
+    pipe_chunk_release(in);
+    return out;
+}
+
+static LineCtx *line_ctx_new(const LineCodec *codec)
+{
+    LineCtx *ctx = safe_malloc(sizeof(LineCtx));
+    ctx->codec = codec;
+    line_state_init(&ctx->st);
+    ctx->lost = 0;
+    return ctx;
+}
+
+int pipeline_add_line_encoder(Pipeline *p, const LineCodec *codec)
+{
+    if (!p || !codec)
+        return -1;
+    return pipeline_add_stage(p, codec->name, line_encoder_stage, line_ctx_new(codec), codec->in_block,
+                              codec->out_block);
+}
+
+int pipeline_add_line_decoder(Pipeline *p, const LineCodec *codec)
+{
+    if (!p || !codec)
+        return -1;
+    return pipeline_add_stage(p, codec->name, line_decoder_stage, line_ctx_new(codec), codec->out_block,
+                              codec->in_block);
+}
+
+typedef struct
+{
+    const LineCodec *codec;
+    double ber;
+    Rng rng;
+    uint64_t flips;
+} ChannelCtx;
+
+static PipeChunk *channel_stage(PipeStage *stage, PipeChunk *in)
+{
+    ChannelCtx *ctx = stage->ctx;
+    PipeChunk *c = pipe_chunk_writable(in);
+    ctx->flips += line_add_noise(ctx->codec, c->data, c->len, ctx->ber, &ctx->rng);
+    return c;
+}
+
+int pipeline_add_channel(Pipeline *p, const LineCodec *codec, double ber, uint64_t seed)
+{
+    if (!p)
+        return -1;
+    ChannelCtx *ctx = safe_malloc(sizeof(ChannelCtx));
+    ctx->codec = codec;
+    ctx->ber = ber;
+    rng_seed(&ctx->rng, seed);
+    ctx->flips = 0;
+    return pipeline_add_stage(p, "Canal", channel_stage, ctx, 1, 1);
+}
+
+typedef struct
+{
+    PipeErrors *out;
+} ErrorCountCtx;
+
+static PipeChunk *error_counter_stage(PipeStage *stage, PipeChunk *in)
+{
+    ErrorCountCtx *ctx = stage->ctx;
+    const PipeChunk *sent = pipe_chunk_origin(in);
+
+    if (sent->len != in->len)
+    {
+        fprintf(stderr, "Error: el trozo %llu llegó con %zu bits (se enviaron %zu)\n",
+                (unsigned long long)in->seq, in->len, sent->len);
+        pipeline_fail(stage->pipe);
+    }
+    else
+    {
+        uint64_t errors = 0, erased = 0;
+        for (size_t i = 0; i < in->len; i++)
+        {
+            errors += (in->data[i] != sent->data[i]);
+            erased += (in->data[i] == BLOCK_ERASURE);
+        }
+        ctx->out->bits += in->len;
+        ctx->out->errors += errors;
+        ctx->out->erased += erased;
+        ctx->out->chunks++;
+    }
+    pipe_chunk_release(in);
+    return NULL;
+}
+
+int pipeline_add_error_counter(Pipeline *p, PipeErrors *out)
+{
+    if (!p || !out || p->n_stages == 0)
+        return -1;
+    memset(out, 0, sizeof(*out));
+    ErrorCountCtx *ctx = safe_malloc(sizeof(ErrorCountCtx));
+    ctx->out = out;
+    p->track_origin = 1;
+    return pipeline_add_stage(p, "Contador de errores", error_counter_stage, ctx, 1, 0);
+}
+
+typedef struct
+{
+    char *dst;
+    size_t cap;
+    size_t *len;
+} CollectorCtx;
+
+static PipeChunk *collector_stage(PipeStage *stage, PipeChunk *in)
+{
+    CollectorCtx *ctx = stage->ctx;
+    size_t room = ctx->cap - *ctx->len;
+    size_t n = (in->len < room) ? in->len : room;
+    memcpy(ctx->dst + *ctx->len, in->data, n);
+    *ctx->len += n;
+    pipe_chunk_release(in);
+    return NULL;
+}
+
+int pipeline_add_collector(Pipeline *p, char *dst, size_t cap, size_t *len)
+{
+    if (!p || !dst || !len || p->n_stages == 0)
+        return -1;
+    *len = 0;
+    CollectorCtx *ctx = safe_malloc(sizeof(CollectorCtx));
+    ctx->dst = dst;
+    ctx->cap = cap;
+    ctx->len = len;
+    return pipeline_add_stage(p, "Colector", collector_stage, ctx, 1, 0);
+}
+
+// ============================================
+// Ejecución
+// ============================================
+
+typedef struct
+{
+    PipeChunk *items[PIPE_QUEUE_DEPTH];
+    size_t head, count;
+    int closed;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty, not_full;
+} PipeQueue;
+
+static void queue_init(PipeQueue *q)
+{
+    q->head = q->count = 0;
+    q->closed = 0;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+}
+
+static void queue_destroy(PipeQueue *q)
+{
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+}
+
+static void queue_push(PipeQueue *q, PipeChunk *c)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->count == PIPE_QUEUE_DEPTH)
+        pthread_cond_wait(&q->not_full, &q->lock);
+    q->items[(q->head + q->count) % PIPE_QUEUE_DEPTH] = c;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/**
+ * Devuelve el siguiente trozo, o NULL si la cola se cerró y está vacía
+ */
+static PipeChunk *queue_pop(PipeQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && !q->closed)
+        pthread_cond_wait(&q->not_empty, &q->lock);
+    PipeChunk *c = NULL;
+    if (q->count > 0)
+    {
+        c = q->items[q->head];
+        q->head = (q->head + 1) % PIPE_QUEUE_DEPTH;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return c;
+}
+
+static void queue_close(PipeQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    q->closed = 1;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+static PipeChunk *stage_step(PipeStage *s, PipeChunk *in)
+{
+    size_t symbols = in ? in->len : 0;
+    double t0 = now_seconds();
+    PipeChunk *out = s->process(s, in);
+    s->seconds += now_seconds() - t0;
+    if (!in && out)
+        symbols = out->len; // Fuente: cuenta lo que emite
+    if (in || out)
+    {
+        s->chunks++;
+        s->symbols += symbols;
+    }
+    return out;
+}
+
+typedef struct
+{
+    PipeStage *stage;
+    PipeQueue *in;     // NULL en la fuente
+    PipeQueue *out;    // Colas de salida contiguas (una por sumidero al final)
+    size_t n_out;
+    int threaded;
+} StageRun;
+
+static void *stage_thread(void *arg)
+{
+    StageRun *r = arg;
+
+    for (;;)
+    {
+        PipeChunk *c = NULL;
+        if (r->in && !(c = queue_pop(r->in)))
+            break;
+        c = stage_step(r->stage, c);
+        if (!c)
+        {
+            if (!r->in)
+                break; // Fuente agotada
+            continue;
+        }
+
+        // Sin destinos, o la tubería ya falló: el trozo se suelta sin bloquear
+        if (r->n_out == 0 || atomic_load(&r->stage->pipe->failed))
+        {
+            pipe_chunk_release(c);
+            continue;
+        }
+        // Referencias de todos los destinos antes de publicar el trozo
+        for (size_t j = 1; j < r->n_out; j++)
+            pipe_chunk_retain(c);
+        for (size_t j = 0; j < r->n_out; j++)
+            queue_push(&r->out[j], c);
+    }
+
+    for (size_t j = 0; j < r->n_out; j++)
+        queue_close(&r->out[j]);
+    return NULL;
+}
+
+static void run_inline(Pipeline *p, size_t n_transforms)
+{
+    size_t n_sinks = p->n_stages - n_transforms;
+    PipeChunk *c;
+
+    while ((c = stage_step(&p->stages[0], NULL)) != NULL)
+    {
+        for (size_t i = 1; c && i < n_transforms; i++)
+            c = stage_step(&p->stages[i], c);
+        if (!c)
+            continue;
+        if (n_sinks == 0)
+        {
+            pipe_chunk_release(c);
+            continue;
+        }
+        for (size_t j = 1; j < n_sinks; j++)
+            pipe_chunk_retain(c);
+        for (size_t j = 0; j < n_sinks; j++)
+            stage_step(&p->stages[n_transforms + j], c);
+    }
+}
+
+static void run_threaded(Pipeline *p, size_t n_transforms)
+{
+    size_t n_stages = p->n_stages;
+    size_t n_sinks = n_stages - n_transforms;
+
+    // Colas: una entre transformaciones consecutivas y una por sumidero
+    size_t n_queues = (n_transforms - 1) + n_sinks;
+    PipeQueue *queues = safe_malloc((n_queues ? n_queues : 1) * sizeof(PipeQueue));
+    for (size_t q = 0; q < n_queues; q++)
+        queue_init(&queues[q]);
+
+    StageRun *runs = safe_malloc(n_stages * sizeof(StageRun));
+    pthread_t *tids = safe_malloc(n_stages * sizeof(pthread_t));
+    for (size_t i = 0; i < n_stages; i++)
+    {
+        StageRun *r = &runs[i];
+        r->stage = &p->stages[i];
+        if (i < n_transforms)
+        {
+            r->in = (i == 0) ? NULL : &queues[i - 1];
+            r->out = &queues[i];
+            r->n_out = (i + 1 < n_transforms) ? 1 : n_sinks;
+        }
+        else
+        {
+            r->in = &queues[n_transforms - 1 + (i - n_transforms)];
+            r->out = NULL;
+            r->n_out = 0;
+        }
+    }
+
+    // Si falta un hilo la tubería se marca fallida (las etapas dejan de
+    // publicar trozos) y esa etapa se vacía aquí cuando todas están lanzadas
+    for (size_t i = 0; i < n_stages; i++)
+    {
+        runs[i].threaded = (pthread_create(&tids[i], NULL, stage_thread, &runs[i]) == 0);
+        if (!runs[i].threaded)
+            pipeline_fail(p);
+    }
+    for (size_t i = 0; i < n_stages; i++)
+        if (!runs[i].threaded)
+            stage_thread(&runs[i]);
+    for (size_t i = 0; i < n_stages; i++)
+        if (runs[i].threaded)
+            pthread_join(tids[i], NULL);
+
+    for (size_t q = 0; q < n_queues; q++)
+        queue_destroy(&queues[q]);
+    free(queues);
+    free(runs);
+    free(tids);
+}
+
+int pipeline_run(Pipeline *p, int threaded)
+{
+    if (!p || p->n_stages == 0 || p->stages[0].sink)
+        return -1;
+
+    if (!p->pool_ready)
+    {
+        if (pool_init(&p->pool, PIPE_HEADER + p->chunk_cap, PIPE_POOL_SLAB) != 0)
+            return -1;
+        p->pool_ready = 1;
+    }
+
+    size_t n_transforms = 0;
+    while (n_transforms < p->n_stages && !p->stages[n_transforms].sink)
+        n_transforms++;
+
+    if (threaded)
+        run_threaded(p, n_transforms);
+    else
+        run_inline(p, n_transforms);
+
+    return atomic_load(&p->failed) ? -1 : 0;
+}
+
+void pipeline_free(Pipeline *p)
+{
+    if (!p)
+        return;
+    for (size_t i = 0; i < p->n_stages; i++)
+        free(p->stages[i].ctx);
+    if (p->pool_ready)
+        pool_destroy(&p->pool);
+    free(p);
+}
+
+// ============================================
+// Reporte
+// ============================================
+
+void run_pipeline_benchmark(Report *report, uint64_t n_bits, double ber, uint64_t seed)
+{
+    if (!report)
+        return;
+
+    const LineCodec *nrzi = codec_find("NRZI");
+    const LineCodec *manchester = codec_find("Manchester");
+    const LineCodec *ami = codec_find("AMI");
+    const BlockCode *b4b5 = block_code_4b5b();
+    const char *names[] = {"Aleatorizador + 4B/5B + NRZI", "Manchester", "Aleatorizador + AMI"};
+
+    report_printf(report, "\n### 12. Pilas de Capa Física en Tubería (%llu bits, BER=%.3f)\n",
+                  (unsigned long long)n_bits, ber);
+    report_printf(report, "Un hilo por etapa, trozos de 32768 bits compartidos por referencia.\n\n");
+    report_table_begin(report, "Pilas en tubería",
+                       "Pila\tEtapas\tBER Decodificado\tBits Borrados\tMbit/s\tEtapa Más Lenta");
+
+    for (int k = 0; k < 3; k++)
+    {
+        Pipeline *p = pipeline_create(32768);
+        PipeErrors errors;
+        int ok = pipeline_add_source(p, n_bits, seed + (uint64_t)k) == 0;
+        switch (k)
+        {
+        case 0:
+            ok &= pipeline_add_scrambler(p, 0x5B) == 0 && pipeline_add_block_encoder(p, b4b5) == 0 &&
+                  pipeline_add_line_encoder(p, nrzi) == 0 && pipeline_add_channel(p, nrzi, ber, seed) == 0 &&
+                  pipeline_add_line_decoder(p, nrzi) == 0 && pipeline_add_block_decoder(p, b4b5) == 0 &&
+                  pipeline_add_scrambler(p, 0x5B) == 0;
+            break;
+        case 1:
+            ok &= pipeline_add_line_encoder(p, manchester) == 0 &&
+                  pipeline_add_channel(p, manchester, ber, seed) == 0 &&
+                  pipeline_add_line_decoder(p, manchester) == 0;
+            break;
+        default:
+            ok &= pipeline_add_scrambler(p, 0x5B) == 0 && pipeline_add_line_encoder(p, ami) == 0 &&
+                  pipeline_add_channel(p, ami, ber, seed) == 0 && pipeline_add_line_decoder(p, ami) == 0 &&
+                  pipeline_add_scrambler(p, 0x5B) == 0;
+            break;
+        }
+        ok &= pipeline_add_error_counter(p, &errors) == 0;
+
+        double t0 = now_seconds();
+        ok = ok && pipeline_run(p, 1) == 0;
+        double elapsed = now_seconds() - t0;
+
+        if (!ok || errors.bits == 0)
+        {
+            report_row(report, 0, "%s\terror\t-\t-\t-\t-", names[k]);
+            pipeline_free(p);
+            continue;
+        }
+
+        size_t slowest = 0;
+        for (size_t i = 1; i < p->n_stages; i++)
+            if (p->stages[i].seconds > p->stages[slowest].seconds)
+                slowest = i;
+
+        report_row(report, 0, "%s\t%zu\t%.2e\t%llu\t%.1f\t%s (%.0f%%)", names[k], p->n_stages,
+                   (double)errors.errors / (double)errors.bits, (unsigned long long)errors.erased,
+                   elapsed > 0 ? (double)errors.bits / elapsed / 1e6 : 0, p->stages[slowest].name,
+                   elapsed > 0 ? 100.0 * p->stages[slowest].seconds / elapsed : 0);
+        pipeline_free(p);
+    }
+}
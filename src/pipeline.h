@@ -0,0 +1,205 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/**
+ * @file pipeline.h
+ * @brief Cadena de etapas de capa física sobre trozos con contador de referencias
+ *
+ * Una tubería es una fuente, una secuencia de transformaciones (aleatorizador,
+ * código de bloque, código de línea, canal, decodificadores) y uno o más
+ * sumideros. Los datos viajan en trozos (PipeChunk) tomados de un
+ * BufferPool; cada etapa recibe la propiedad del trozo y:
+ *
+ * - lo modifica en su lugar si la salida mide lo mismo (canal,
+ *   aleatorizador, NRZ/NRZI/AMI), o
+ * - escribe en un trozo nuevo y suelta el de entrada (4B/5B, Manchester).
+ *
+ * Cada trozo lleva una referencia al trozo original de la fuente, así un
+ * sumidero puede contar errores sin que nadie copie los bits enviados.
+ * Modificar un trozo compartido lo copia antes (copia en escritura).
+ *
+ * Ejecución: en línea (todas las etapas en el hilo llamador) o con un hilo
+ * por etapa unido por colas acotadas. Las etapas tienen estado (LineState,
+ * flujo aleatorio, registro del aleatorizador) y reciben los trozos en
+ * orden, así que ambos modos dan el mismo resultado.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "arena.h"
+#include "blockcode.h"
+#include "codec.h"
+#include "report.h"
+
+// Etapas por tubería
+#define PIPE_MAX_STAGES 16
+
+// Trozos en vuelo entre dos etapas consecutivas (modo con hilos)
+#define PIPE_QUEUE_DEPTH 4
+
+typedef struct Pipeline Pipeline;
+
+typedef struct PipeChunk
+{
+    atomic_int refs;
+    struct PipeChunk *origin;  // Trozo de la fuente del que proviene (referencia propia), o NULL
+    Pipeline *pipe;
+    uint64_t seq;              // Número de trozo dentro del flujo
+    size_t len;                // Símbolos válidos en data
+    char *data;                // Pipeline.chunk_cap bytes, en el mismo buffer del pool
+} PipeChunk;
+
+typedef struct PipeStage PipeStage;
+
+/**
+ * @brief Procesa un trozo
+ *
+ * La etapa recibe la propiedad de `in` y devuelve el trozo que sigue por la
+ * tubería (el mismo u otro). La fuente recibe in = NULL y devuelve NULL al
+ * terminar; los sumideros devuelven NULL. Ante un error la etapa suelta sus
+ * trozos, llama a pipeline_fail y devuelve NULL.
+ */
+typedef PipeChunk *(*pipe_stage_fn)(PipeStage *stage, PipeChunk *in);
+
+struct PipeStage
+{
+    const char *name;
+    pipe_stage_fn process;
+    void *ctx;              // Estado propio (se libera con free en pipeline_free)
+    int sink;
+    Pipeline *pipe;
+    // Métricas (cada etapa las actualiza solo desde su hilo)
+    uint64_t chunks;
+    uint64_t symbols;       // Símbolos de entrada procesados
+    double seconds;         // Tiempo dentro de process
+};
+
+struct Pipeline
+{
+    PipeStage stages[PIPE_MAX_STAGES];
+    size_t n_stages;
+    size_t chunk_bits;      // Bits por trozo en la fuente
+    size_t cur_len;         // Longitud de un trozo completo tras la última etapa
+    size_t chunk_cap;       // Mayor longitud de trozo en toda la tubería
+    int track_origin;       // Algún sumidero necesita los bits de la fuente
+    BufferPool pool;
+    int pool_ready;
+    atomic_int failed;
+};
+
+typedef struct
+{
+    uint64_t bits;      // Bits comparados
+    uint64_t errors;    // Bits distintos de los enviados (incluye borrados)
+    uint64_t erased;    // Bits marcados BLOCK_ERASURE
+    uint64_t chunks;
+} PipeErrors;
+
+/**
+ * @brief Crea una tubería vacía
+ * @param chunk_bits Bits por trozo (múltiplo de los bloques de todas las etapas)
+ * @return Tubería, o NULL si hubo error
+ */
+Pipeline *pipeline_create(size_t chunk_bits);
+
+/**
+ * @brief Agrega una etapa propia (punto de extensión)
+ * @param in_block Símbolos de entrada por bloque
+ * @param out_block Símbolos de salida por bloque (0 para un sumidero)
+ * @return 0 si tuvo éxito, -1 si el orden o los tamaños no son válidos
+ */
+int pipeline_add_stage(Pipeline *p, const char *name, pipe_stage_fn fn, void *ctx, unsigned in_block,
+                       unsigned out_block);
+
+/**
+ * @brief Fuente de bits aleatorios ('0'/'1')
+ * @param total_bits Bits a emitir en total
+ */
+int pipeline_add_source(Pipeline *p, uint64_t total_bits, uint64_t seed);
+
+/**
+ * @brief Aleatorizador aditivo x^7 + x^4 + 1 (el mismo deshace el efecto)
+ * @param seed Estado inicial del registro (7 bits, distinto de 0)
+ */
+int pipeline_add_scrambler(Pipeline *p, unsigned seed);
+
+int pipeline_add_block_encoder(Pipeline *p, const BlockCode *code);
+
+/**
+ * @brief Decodificador de bloque con borraduras (nunca aborta el flujo)
+ */
+int pipeline_add_block_decoder(Pipeline *p, const BlockCode *code);
+
+int pipeline_add_line_encoder(Pipeline *p, const LineCodec *codec);
+
+/**
+ * @brief Decodificador de línea; los bloques inválidos salen como BLOCK_ERASURE
+ */
+int pipeline_add_line_decoder(Pipeline *p, const LineCodec *codec);
+
+/**
+ * @brief Canal binario simétrico sobre los símbolos del esquema indicado
+ */
+int pipeline_add_channel(Pipeline *p, const LineCodec *codec, double ber, uint64_t seed);
+
+/**
+ * @brief Sumidero que compara con los bits de la fuente
+ * @param out Contadores (se ponen a cero al agregar la etapa)
+ */
+int pipeline_add_error_counter(Pipeline *p, PipeErrors *out);
+
+/**
+ * @brief Sumidero que copia los símbolos a un buffer del llamador
+ * @param dst Destino
+ * @param cap Capacidad de dst (lo que no cabe se descarta)
+ * @param len Salida: símbolos escritos
+ */
+int pipeline_add_collector(Pipeline *p, char *dst, size_t cap, size_t *len);
+
+/**
+ * @brief Ejecuta la tubería hasta agotar la fuente
+ * @param threaded 0: todas las etapas en este hilo; 1: un hilo por etapa
+ * @return 0 si tuvo éxito, -1 si alguna etapa falló
+ */
+int pipeline_run(Pipeline *p, int threaded);
+
+/**
+ * @brief Marca la tubería como fallida (desde cualquier etapa)
+ */
+void pipeline_fail(Pipeline *p);
+
+/**
+ * @brief Toma un trozo vacío del pool (una referencia)
+ */
+PipeChunk *pipe_chunk_new(Pipeline *p);
+
+/**
+ * @brief Trozo nuevo para la salida de una etapa que no trabaja en su lugar
+ *
+ * Hereda el número de trozo y el origen de `in`; el llamador sigue siendo
+ * dueño de `in` y debe soltarlo después de leerlo.
+ */
+PipeChunk *pipe_chunk_derive(PipeChunk *in);
+
+/**
+ * @brief Devuelve un trozo que se puede modificar (copia solo si es compartido)
+ */
+PipeChunk *pipe_chunk_writable(PipeChunk *c);
+
+void pipe_chunk_retain(PipeChunk *c);
+void pipe_chunk_release(PipeChunk *c);
+
+/**
+ * @brief Bits de la fuente de los que proviene el trozo
+ */
+const PipeChunk *pipe_chunk_origin(const PipeChunk *c);
+
+void pipeline_free(Pipeline *p);
+
+/**
+ * @brief Agrega al reporte el rendimiento de algunas pilas completas
+ */
+void run_pipeline_benchmark(Report *report, uint64_t n_bits, double ber, uint64_t seed);
+
+#endif // PIPELINE_H
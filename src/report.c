@@ -0,0 +1,357 @@
+#include "report.h"
+#include "utils.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================
+// Sesión
+// ============================================
+
+Report *report_open(const char *md_path)
+{
+    if (!md_path)
+        return NULL;
+
+    FILE *md = fopen(md_path, "w");
+    if (!md)
+    {
+        fprintf(stderr, "Error: no se pudo crear %s\n", md_path);
+        return NULL;
+    }
+    setvbuf(md, NULL, _IOFBF, REPORT_BUFFER_SIZE);
+
+    Report *r = safe_malloc(sizeof(Report));
+    memset(r, 0, sizeof(*r));
+    r->md = md;
+
+    // Base: la ruta sin la extensión del Markdown
+    size_t len = strlen(md_path);
+    const char *dot = strrchr(md_path, '.');
+    const char *slash = strrchr(md_path, '/');
+    if (dot && (!slash || dot > slash))
+        len = (size_t)(dot - md_path);
+    r->base = safe_malloc(len + 1);
+    memcpy(r->base, md_path, len);
+    r->base[len] = '\0';
+    return r;
+}
+
+void report_printf(Report *r, const char *fmt, ...)
+{
+    if (!r)
+        return;
+    report_table_end(r);
+
+    va_list ap;
+    va_start(ap, fmt);
+    vfprintf(r->md, fmt, ap);
+    va_end(ap);
+}
+
+// ============================================
+// Tablas
+// ============================================
+
+/**
+ * Copia `s` reemplazando '\t' por '\0' y devuelve el número de celdas
+ */
+static size_t split_cells(const char *s, char *dst)
+{
+    size_t cells = 1;
+    for (; *s; s++, dst++)
+    {
+        *dst = (*s == '\t') ? '\0' : *s;
+        cells += (*s == '\t');
+    }
+    *dst = '\0';
+    return cells;
+}
+
+void report_table_begin(Report *r, const char *title, const char *columns)
+{
+    if (!r || !columns)
+        return;
+    report_table_end(r);
+
+    ReportTable *t = safe_malloc(sizeof(ReportTable));
+    memset(t, 0, sizeof(*t));
+    t->title = string_duplicate(title ? title : "");
+
+    char *names = safe_malloc(strlen(columns) + 1);
+    t->n_cols = split_cells(columns, names);
+    t->columns = safe_malloc(t->n_cols * sizeof(char *));
+    for (size_t c = 0; c < t->n_cols; c++)
+    {
+        t->columns[c] = names;
+        names += strlen(names) + 1;
+    }
+
+    if (r->n_tables == r->cap_tables)
+    {
+        r->cap_tables = r->cap_tables ? 2 * r->cap_tables : 16;
+        ReportTable **tmp = realloc(r->tables, r->cap_tables * sizeof(ReportTable *));
+        if (!tmp)
+        {
+            fprintf(stderr, "Error: sin memoria para el informe\n");
+            exit(EXIT_FAILURE);
+        }
+        r->tables = tmp;
+    }
+    r->tables[r->n_tables++] = t;
+    r->current = t;
+}
+
+int report_row(Report *r, unsigned shard, const char *fmt, ...)
+{
+    if (!r || !r->current || shard >= REPORT_MAX_SHARDS)
+        return -1;
+
+    char local[512];
+    char *text = local;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(local, sizeof(local), fmt, ap);
+    va_end(ap);
+    if (n < 0)
+        return -1;
+    if ((size_t)n >= sizeof(local))
+    {
+        text = safe_malloc((size_t)n + 1);
+        va_start(ap, fmt);
+        vsnprintf(text, (size_t)n + 1, fmt, ap);
+        va_end(ap);
+    }
+
+    // Cada hilo escribe solo en su fragmento: no hace falta sincronizar
+    ReportShard *s = &r->current->shards[shard];
+    if (s->len + (size_t)n + 1 > s->cap)
+    {
+        size_t cap = s->cap ? 2 * s->cap : 1024;
+        while (cap < s->len + (size_t)n + 1)
+            cap *= 2;
+        char *tmp = realloc(s->data, cap);
+        if (!tmp)
+        {
+            fprintf(stderr, "Error: sin memoria para el informe\n");
+            exit(EXIT_FAILURE);
+        }
+        s->data = tmp;
+        s->cap = cap;
+    }
+
+    size_t cells = split_cells(text, s->data + s->len);
+    if (text != local)
+        free(text);
+    if (cells != r->current->n_cols)
+    {
+        fprintf(stderr, "Error: fila con %zu celdas en una tabla de %zu columnas\n", cells, r->current->n_cols);
+        return -1;
+    }
+
+    s->len += (size_t)n + 1;
+    s->rows++;
+    return 0;
+}
+
+size_t report_table_rows(const Report *r)
+{
+    if (!r || !r->current)
+        return 0;
+
+    size_t rows = 0;
+    for (unsigned s = 0; s < REPORT_MAX_SHARDS; s++)
+        rows += r->current->shards[s].rows;
+    return rows;
+}
+
+void report_table_end(Report *r)
+{
+    if (!r || !r->current)
+        return;
+
+    ReportTable *t = r->current;
+    r->current = NULL;
+
+    fprintf(r->md, "|");
+    for (size_t c = 0; c < t->n_cols; c++)
+        fprintf(r->md, " %s |", t->columns[c]);
+    fprintf(r->md, "\n|");
+    for (size_t c = 0; c < t->n_cols; c++)
+        fprintf(r->md, (c == 0) ? " :--- |" : " :---: |");
+    fprintf(r->md, "\n");
+
+    for (unsigned s = 0; s < REPORT_MAX_SHARDS; s++)
+    {
+        const char *cell = t->shards[s].data;
+        for (size_t row = 0; row < t->shards[s].rows; row++)
+        {
+            fprintf(r->md, "|");
+            for (size_t c = 0; c < t->n_cols; c++, cell += strlen(cell) + 1)
+                fprintf(r->md, " %s |", cell);
+            fprintf(r->md, "\n");
+        }
+    }
+}
+
+// ============================================
+// CSV y JSON
+// ============================================
+
+static void csv_field(FILE *f, const char *s)
+{
+    if (!strpbrk(s, ",\"\n"))
+    {
+        fputs(s, f);
+        return;
+    }
+    fputc('"', f);
+    for (; *s; s++)
+    {
+        if (*s == '"')
+            fputc('"', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void json_string(FILE *f, const char *s)
+{
+    fputc('"', f);
+    for (; *s; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+/**
+ * Las celdas que son números completos se emiten como números JSON
+ */
+static void json_value(FILE *f, const char *s)
+{
+    char *end;
+    double v = strtod(s, &end);
+    if (*s && *end == '\0' && isfinite(v) && !strpbrk(s, "xX"))
+        fputs(s[0] == '+' ? s + 1 : s, f);
+    else
+        json_string(f, s);
+}
+
+static int write_csv(const Report *r, const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return -1;
+
+    // Formato largo: una línea por celda, válido aunque las tablas difieran
+    fprintf(f, "tabla,fila,columna,valor\n");
+    for (size_t i = 0; i < r->n_tables; i++)
+    {
+        const ReportTable *t = r->tables[i];
+        size_t row_id = 0;
+        for (unsigned s = 0; s < REPORT_MAX_SHARDS; s++)
+        {
+            const char *cell = t->shards[s].data;
+            for (size_t row = 0; row < t->shards[s].rows; row++, row_id++)
+            {
+                for (size_t c = 0; c < t->n_cols; c++, cell += strlen(cell) + 1)
+                {
+                    csv_field(f, t->title);
+                    fprintf(f, ",%zu,", row_id);
+                    csv_field(f, t->columns[c]);
+                    fputc(',', f);
+                    csv_field(f, cell);
+                    fputc('\n', f);
+                }
+            }
+        }
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+static int write_json(const Report *r, const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return -1;
+
+    fprintf(f, "{\"tablas\": [");
+    for (size_t i = 0; i < r->n_tables; i++)
+    {
+        const ReportTable *t = r->tables[i];
+        fprintf(f, "%s\n  {\"titulo\": ", i ? "," : "");
+        json_string(f, t->title);
+        fprintf(f, ", \"columnas\": [");
+        for (size_t c = 0; c < t->n_cols; c++)
+        {
+            fprintf(f, c ? ", " : "");
+            json_string(f, t->columns[c]);
+        }
+        fprintf(f, "], \"filas\": [");
+
+        int first = 1;
+        for (unsigned s = 0; s < REPORT_MAX_SHARDS; s++)
+        {
+            const char *cell = t->shards[s].data;
+            for (size_t row = 0; row < t->shards[s].rows; row++, first = 0)
+            {
+                fprintf(f, "%s\n    [", first ? "" : ",");
+                for (size_t c = 0; c < t->n_cols; c++, cell += strlen(cell) + 1)
+                {
+                    fprintf(f, c ? ", " : "");
+                    json_value(f, cell);
+                }
+                fprintf(f, "]");
+            }
+        }
+        fprintf(f, "]}");
+    }
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int report_close(Report *r)
+{
+    if (!r)
+        return -1;
+    report_table_end(r);
+
+    int status = (fclose(r->md) == 0) ? 0 : -1;
+
+    size_t blen = strlen(r->base);
+    char *path = safe_malloc(blen + 6);
+    memcpy(path, r->base, blen);
+    strcpy(path + blen, ".csv");
+    if (write_csv(r, path) != 0)
+        status = -1;
+    strcpy(path + blen, ".json");
+    if (write_json(r, path) != 0)
+        status = -1;
+    if (status != 0)
+        fprintf(stderr, "Error: no se pudo escribir el informe %s\n", r->base);
+    free(path);
+
+    for (size_t i = 0; i < r->n_tables; i++)
+    {
+        ReportTable *t = r->tables[i];
+        for (unsigned s = 0; s < REPORT_MAX_SHARDS; s++)
+            free(t->shards[s].data);
+        if (t->n_cols > 0)
+            free(t->columns[0]);
+        free(t->columns);
+        free(t->title);
+        free(t);
+    }
+    free(r->tables);
+    free(r->base);
+    free(r);
+    return status;
+}
@@ -0,0 +1,98 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+/**
+ * @file report.h
+ * @brief Sesión de informe: un solo archivo abierto con buffer y tablas en memoria
+ *
+ * El texto libre se escribe en el Markdown a través de un único FILE* con
+ * buffer grande (en lugar de abrir y cerrar el archivo en cada función).
+ * Las filas de las tablas se guardan en memoria y, al cerrar la sesión,
+ * se emiten también como CSV y JSON junto al Markdown
+ * (results/analysis.md → results/analysis.csv, results/analysis.json).
+ *
+ * Concurrencia: cada hilo agrega filas a su propio fragmento (shard) de la
+ * tabla abierta, sin candados. Al cerrar la tabla los fragmentos se unen
+ * en orden de índice, así que el resultado no depende del planificador.
+ * Abrir/cerrar tablas y escribir texto se hace solo desde el hilo principal.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Fragmentos por tabla (índice de hilo válido: 0 .. REPORT_MAX_SHARDS-1)
+#define REPORT_MAX_SHARDS 64
+
+// Tamaño del buffer del archivo Markdown
+#define REPORT_BUFFER_SIZE (1u << 16)
+
+typedef struct
+{
+    _Alignas(64) char *data; // Celdas terminadas en '\0', n_cols por fila
+    size_t len, cap;
+    size_t rows;
+} ReportShard;
+
+typedef struct
+{
+    char *title;
+    char **columns;
+    size_t n_cols;
+    ReportShard shards[REPORT_MAX_SHARDS];
+} ReportTable;
+
+typedef struct
+{
+    FILE *md;
+    char *base;            // Ruta sin extensión (para .csv y .json)
+    ReportTable **tables;
+    size_t n_tables, cap_tables;
+    ReportTable *current;  // Tabla que recibe filas, o NULL
+} Report;
+
+/**
+ * @brief Abre una sesión (trunca el Markdown)
+ * @param md_path Ruta del Markdown, ej: "results/analysis.md"
+ * @return Sesión, o NULL si no se pudo crear el archivo
+ */
+Report *report_open(const char *md_path);
+
+/**
+ * @brief Escribe texto libre en el Markdown (cierra la tabla abierta, si la hay)
+ */
+void report_printf(Report *r, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Abre una tabla; las filas siguientes se agregan a ella
+ * @param r Sesión
+ * @param title Título para CSV/JSON (el encabezado Markdown lo escribe el llamador)
+ * @param columns Nombres de columna separados por '\t'
+ */
+void report_table_begin(Report *r, const char *title, const char *columns);
+
+/**
+ * @brief Agrega una fila a la tabla abierta
+ * @param r Sesión
+ * @param shard Fragmento del hilo que llama (0 desde código secuencial)
+ * @param fmt Formato printf; las celdas se separan con '\t'
+ * @return 0 si tuvo éxito, -1 si no hay tabla abierta o el número de celdas no coincide
+ */
+int report_row(Report *r, unsigned shard, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Emite la tabla abierta en el Markdown (une los fragmentos)
+ */
+void report_table_end(Report *r);
+
+/**
+ * @brief Filas acumuladas en la tabla abierta (todos los fragmentos)
+ */
+size_t report_table_rows(const Report *r);
+
+/**
+ * @brief Cierra la sesión: termina el Markdown y escribe el CSV y el JSON
+ * @return 0 si todo se escribió, -1 si hubo algún error
+ */
+int report_close(Report *r);
+
+#endif // REPORT_H
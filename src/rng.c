@@ -0,0 +1,15 @@
+#include "rng.h"
+
+/**
+ * @brief Inicializa el generador con una semilla
+ * @param rng Generador a inicializar
+ * @param seed Semilla (cualquier valor, incluido 0)
+ */
+void rng_seed(Rng *rng, uint64_t seed)
+{
+    if (!rng)
+        return;
+    rng->state = seed;
+    // Descartamos una salida para separar semillas consecutivas
+    (void)rng_next(rng);
+}
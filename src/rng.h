@@ -0,0 +1,46 @@
+#ifndef RNG_H
+#define RNG_H
+
+/**
+ * @file rng.h
+ * @brief Generador pseudoaleatorio rápido y reproducible (SplitMix64)
+ *
+ * A diferencia de rand(), el estado es explícito: cada simulación puede
+ * llevar su propio flujo, y la posición dentro del flujo es simplemente
+ * el valor de @c state (útil para repetir o reanudar experimentos).
+ */
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint64_t state;
+} Rng;
+
+/**
+ * @brief Inicializa el generador con una semilla
+ * @param rng Generador a inicializar
+ * @param seed Semilla (cualquier valor, incluido 0)
+ */
+void rng_seed(Rng *rng, uint64_t seed);
+
+/**
+ * @brief Devuelve el siguiente entero de 64 bits del flujo
+ */
+static inline uint64_t rng_next(Rng *rng)
+{
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Devuelve un real uniforme en [0, 1) con 53 bits de resolución
+ */
+static inline double rng_uniform(Rng *rng)
+{
+    return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif // RNG_H
@@ -0,0 +1,414 @@
+#include "spectrum.h"
+#include "rng.h"
+#include "utils.h"
+#include "arena.h"
+#include "bitpack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PSD_PI 3.14159265358979323846
+
+// Tamaño de bloque (en puntos complejos) cuyas etapas se completan juntas:
+// 1024 puntos = 16 KB entre parte real e imaginaria, cabe en L1
+#define FFT_BLOCK 1024
+
+// Transformadas complejas por lote; cada una lleva DOS segmentos reales
+#define PSD_BATCH 8
+
+// Bits de información generados y codificados por trozo
+#define PSD_CHUNK_BITS 65536
+
+// Un nulo debe caer por debajo de esta fracción del pico del lóbulo principal
+#define PSD_NULL_REL 0.05
+
+// ============================================
+// FFT
+// ============================================
+
+int fft_plan_init(FftPlan *plan, size_t n)
+{
+    if (!plan || n < 2 || (n & (n - 1)) != 0 || n > ((size_t)1 << 30))
+    {
+        fprintf(stderr, "Error: tamaño de FFT inválido (%zu)\n", n);
+        return -1;
+    }
+
+    plan->n = n;
+    plan->log2n = 0;
+    while (((size_t)1 << plan->log2n) < n)
+        plan->log2n++;
+
+    plan->tw_re = safe_malloc((n / 2) * sizeof(double));
+    plan->tw_im = safe_malloc((n / 2) * sizeof(double));
+    plan->rev = safe_malloc(n * sizeof(uint32_t));
+
+    for (size_t k = 0; k < n / 2; k++)
+    {
+        double ang = -2.0 * PSD_PI * (double)k / (double)n;
+        plan->tw_re[k] = cos(ang);
+        plan->tw_im[k] = sin(ang);
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t r = 0;
+        for (unsigned b = 0; b < plan->log2n; b++)
+            r |= (uint32_t)((i >> b) & 1) << (plan->log2n - 1 - b);
+        plan->rev[i] = r;
+    }
+    return 0;
+}
+
+void fft_plan_free(FftPlan *plan)
+{
+    if (!plan)
+        return;
+    free(plan->tw_re);
+    free(plan->tw_im);
+    free(plan->rev);
+    plan->tw_re = plan->tw_im = NULL;
+    plan->rev = NULL;
+}
+
+/**
+ * Aplica una etapa de mariposas (semiancho `half`) sobre `len` puntos.
+ * `tstride` es el salto en la tabla de twiddles: n / (2 * half).
+ */
+static void fft_stage(double *re, double *im, size_t len, size_t half,
+                      const double *tw_re, const double *tw_im, size_t tstride)
+{
+    for (size_t start = 0; start < len; start += 2 * half)
+    {
+        double *ar = re + start, *ai = im + start;
+        double *br = ar + half, *bi = ai + half;
+
+        for (size_t j = 0; j < half; j++)
+        {
+            double wr = tw_re[j * tstride];
+            double wi = tw_im[j * tstride];
+            double tr = br[j] * wr - bi[j] * wi;
+            double ti = br[j] * wi + bi[j] * wr;
+
+            br[j] = ar[j] - tr;
+            bi[j] = ai[j] - ti;
+            ar[j] += tr;
+            ai[j] += ti;
+        }
+    }
+}
+
+static void fft_execute_one(const FftPlan *plan, double *re, double *im)
+{
+    size_t n = plan->n;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t r = plan->rev[i];
+        if (i < r)
+        {
+            double t = re[i];
+            re[i] = re[r];
+            re[r] = t;
+            t = im[i];
+            im[i] = im[r];
+            im[r] = t;
+        }
+    }
+
+    // Etapas cortas: cada bloque se termina mientras sigue en caché
+    size_t blk = (n < FFT_BLOCK) ? n : FFT_BLOCK;
+    for (size_t base = 0; base < n; base += blk)
+    {
+        for (size_t half = 1; half < blk; half <<= 1)
+            fft_stage(re + base, im + base, blk, half, plan->tw_re, plan->tw_im, n / (2 * half));
+    }
+
+    // Etapas largas: recorren la transformada completa
+    for (size_t half = blk; half < n; half <<= 1)
+        fft_stage(re, im, n, half, plan->tw_re, plan->tw_im, n / (2 * half));
+}
+
+void fft_execute_batch(const FftPlan *plan, double *re, double *im, size_t count)
+{
+    if (!plan || !re || !im)
+        return;
+
+    for (size_t t = 0; t < count; t++)
+        fft_execute_one(plan, re + t * plan->n, im + t * plan->n);
+}
+
+// ============================================
+// PSD (Welch)
+// ============================================
+
+/**
+ * Nivel físico de un símbolo: alto → +1, bajo → -1
+ */
+static double level_value(char c)
+{
+    switch (c)
+    {
+    case 'H':
+    case 'h':
+    case '1':
+    case '+':
+        return 1.0;
+    default:
+        return -1.0;
+    }
+}
+
+typedef struct
+{
+    const FftPlan *plan;
+    const double *window;
+    double *re;          // Lote: PSD_BATCH transformadas
+    double *im;
+    size_t filled;       // Segmentos reales cargados en el lote
+    double *acc;         // Acumulador |X|^2 por bin
+    size_t segments;
+} WelchState;
+
+/**
+ * Transforma el lote pendiente. Cada transformada compleja lleva dos
+ * segmentos reales (a en la parte real, b en la imaginaria), que se separan
+ * por simetría: A[k] = (X[k] + X*[n-k]) / 2, B[k] = (X[k] - X*[n-k]) / 2i.
+ */
+static void welch_flush(WelchState *ws)
+{
+    if (ws->filled == 0)
+        return;
+
+    size_t n = ws->plan->n;
+    size_t count = (ws->filled + 1) / 2;
+
+    fft_execute_batch(ws->plan, ws->re, ws->im, count);
+
+    for (size_t t = 0; t < count; t++)
+    {
+        const double *xr = ws->re + t * n;
+        const double *xi = ws->im + t * n;
+
+        for (size_t k = 0; k <= n / 2; k++)
+        {
+            size_t nk = (n - k) & (n - 1);
+            double ar = 0.5 * (xr[k] + xr[nk]);
+            double ai = 0.5 * (xi[k] - xi[nk]);
+            double br = 0.5 * (xi[k] + xi[nk]);
+            double bi = -0.5 * (xr[k] - xr[nk]);
+            double p = ar * ar + ai * ai + br * br + bi * bi;
+
+            // Espectro unilateral: los bins interiores cuentan doble
+            ws->acc[k] += (k == 0 || k == n / 2) ? p : 2.0 * p;
+        }
+    }
+
+    ws->segments += ws->filled;
+    ws->filled = 0;
+}
+
+static void welch_push(WelchState *ws, const double *samples)
+{
+    size_t n = ws->plan->n;
+    size_t slot = ws->filled / 2;
+    double *dst = (ws->filled % 2 == 0) ? ws->re + slot * n : ws->im + slot * n;
+
+    for (size_t i = 0; i < n; i++)
+        dst[i] = samples[i] * ws->window[i];
+
+    // Si el lote termina con un número impar de segmentos, la parte
+    // imaginaria de la última transformada debe quedar en cero
+    if (ws->filled % 2 == 0)
+        memset(ws->im + slot * n, 0, n * sizeof(double));
+
+    if (++ws->filled == 2 * PSD_BATCH)
+        welch_flush(ws);
+}
+
+/**
+ * Primer nulo después del pico del lóbulo principal: primer mínimo local
+ * que cae por debajo de PSD_NULL_REL veces el pico.
+ */
+static size_t find_first_null(const double *psd, size_t n_bins)
+{
+    size_t peak = 0;
+    for (size_t k = 1; k < n_bins; k++)
+        if (psd[k] > psd[peak])
+            peak = k;
+
+    for (size_t k = peak + 1; k + 1 < n_bins; k++)
+    {
+        if (psd[k] < PSD_NULL_REL * psd[peak] && psd[k] <= psd[k - 1] && psd[k] <= psd[k + 1])
+            return k;
+    }
+    return 0;
+}
+
+int psd_welch(encode_ptr encode, size_t n_bits, size_t bit_multiple, unsigned sps,
+              size_t nfft, uint64_t seed, PsdResult *out)
+{
+    if (!encode || !out || sps == 0 || bit_multiple == 0)
+        return -1;
+
+    memset(out, 0, sizeof(*out));
+
+    FftPlan plan;
+    if (fft_plan_init(&plan, nfft) != 0)
+        return -1;
+
+    size_t chunk_bits = (PSD_CHUNK_BITS / bit_multiple) * bit_multiple;
+    if (chunk_bits == 0)
+        chunk_bits = bit_multiple;
+
+    double *window = safe_malloc(nfft * sizeof(double));
+    double wpow = 0;
+    for (size_t i = 0; i < nfft; i++)
+    {
+        window[i] = 0.5 - 0.5 * cos(2.0 * PSD_PI * (double)i / (double)nfft);
+        wpow += window[i] * window[i];
+    }
+
+    WelchState ws = {0};
+    ws.plan = &plan;
+    ws.window = window;
+    ws.re = safe_malloc(PSD_BATCH * nfft * sizeof(double));
+    ws.im = safe_malloc(PSD_BATCH * nfft * sizeof(double));
+    ws.acc = calloc(nfft / 2 + 1, sizeof(double));
+    if (!ws.acc)
+    {
+        fprintf(stderr, "Error: sin memoria para la PSD\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char *bits = safe_malloc(chunk_bits + 1);
+    uint64_t *words = safe_malloc((chunk_bits / 64 + 1) * sizeof(uint64_t));
+    double *samples = NULL;
+    size_t cap = 0, avail = 0;
+    double symbols_per_bit = 0;
+    size_t hop = nfft / 2;
+    int status = 0;
+
+    Rng rng;
+    rng_seed(&rng, seed);
+
+    // La señal de cada trozo se descarta en cuanto se convierte a muestras
+    Arena arena;
+    arena_init(&arena, 4 * chunk_bits + 64);
+    Arena *prev_arena = arena_set_current(&arena);
+
+    for (size_t produced = 0; produced < n_bits;)
+    {
+        arena_reset(&arena);
+        size_t this_bits = n_bits - produced;
+        if (this_bits > chunk_bits)
+            this_bits = chunk_bits;
+        this_bits = (this_bits / bit_multiple) * bit_multiple;
+        if (this_bits == 0)
+            break;
+
+        for (size_t i = 0; i < this_bits; i += 64)
+            words[i / 64] = rng_next(&rng);
+        bits_unpack((const uint8_t *)words, this_bits, bits, '0', '1');
+        bits[this_bits] = '\0';
+
+        char *enc = encode(bits);
+        if (!enc)
+        {
+            status = -1;
+            break;
+        }
+
+        size_t enc_len = strlen(enc);
+        if (symbols_per_bit == 0)
+            symbols_per_bit = (double)enc_len / (double)this_bits;
+
+        size_t need = avail + enc_len * sps;
+        if (need > cap)
+        {
+            cap = need;
+            double *tmp = realloc(samples, cap * sizeof(double));
+            if (!tmp)
+            {
+                status = -1;
+                break;
+            }
+            samples = tmp;
+        }
+
+        for (size_t i = 0; i < enc_len; i++)
+        {
+            double v = level_value(enc[i]);
+            for (unsigned s = 0; s < sps; s++)
+                samples[avail++] = v;
+        }
+
+        size_t pos = 0;
+        while (avail - pos >= nfft)
+        {
+            welch_push(&ws, samples + pos);
+            pos += hop;
+        }
+        memmove(samples, samples + pos, (avail - pos) * sizeof(double));
+        avail -= pos;
+
+        produced += this_bits;
+    }
+
+    arena_set_current(prev_arena);
+    arena_free(&arena);
+
+    welch_flush(&ws);
+
+    if (status == 0 && ws.segments == 0)
+    {
+        fprintf(stderr, "Error: muy pocos bits para un segmento de %zu puntos\n", nfft);
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        out->nfft = nfft;
+        out->n_bins = nfft / 2 + 1;
+        out->segments = ws.segments;
+        out->psd = ws.acc;
+        ws.acc = NULL;
+
+        double total = 0;
+        for (size_t k = 0; k < out->n_bins; k++)
+        {
+            out->psd[k] /= (wpow * (double)out->segments);
+            total += out->psd[k];
+        }
+        for (size_t k = 0; k < out->n_bins; k++)
+            out->psd[k] = (total > 0) ? out->psd[k] / total : 0;
+
+        // Bin k ↔ k·sps/nfft veces la tasa de símbolos, que es symbols_per_bit·Rb
+        out->bin_width = (double)sps * symbols_per_bit / (double)nfft;
+
+        size_t null_bin = find_first_null(out->psd, out->n_bins);
+        out->null_bw = null_bin * out->bin_width;
+
+        for (size_t k = 0; k < out->n_bins && k * out->bin_width <= PSD_DC_BAND; k++)
+            out->dc_fraction += out->psd[k];
+    }
+
+    free(ws.acc);
+    free(ws.re);
+    free(ws.im);
+    free(window);
+    free(bits);
+    free(words);
+    free(samples);
+    fft_plan_free(&plan);
+    return status;
+}
+
+void psd_free(PsdResult *result)
+{
+    if (!result)
+        return;
+    free(result->psd);
+    result->psd = NULL;
+}
@@ -0,0 +1,90 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+/**
+ * @file spectrum.h
+ * @brief Densidad espectral de potencia (PSD) de las señales codificadas
+ *
+ * - FFT radix-2 propia con twiddles precalculados y etapas por bloques
+ *   (las etapas cortas se completan dentro de un bloque que cabe en caché)
+ * - Estimador de Welch (ventana de Hann, solapamiento 50%) sobre flujos
+ *   aleatorios generados por trozos: la memoria no depende de la longitud
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "analysis.h"
+
+// ============================================
+// FFT
+// ============================================
+
+typedef struct
+{
+    size_t n;         // Puntos de la transformada (potencia de 2)
+    unsigned log2n;   // log2(n)
+    double *tw_re;    // Twiddles e^{-2πik/n}, k < n/2 (parte real)
+    double *tw_im;    // (parte imaginaria)
+    uint32_t *rev;    // Permutación de inversión de bits
+} FftPlan;
+
+/**
+ * @brief Prepara una FFT de n puntos (tablas de twiddles y bit-reversal)
+ * @param plan Plan a inicializar
+ * @param n Número de puntos (potencia de 2, >= 2)
+ * @return 0 si tuvo éxito, -1 si n no es válido
+ */
+int fft_plan_init(FftPlan *plan, size_t n);
+
+/**
+ * @brief Libera las tablas del plan
+ */
+void fft_plan_free(FftPlan *plan);
+
+/**
+ * @brief FFT compleja in-place de `count` transformadas contiguas
+ * @param plan Plan de n puntos
+ * @param re Partes reales (count * n valores)
+ * @param im Partes imaginarias (count * n valores)
+ * @param count Número de transformadas del lote
+ */
+void fft_execute_batch(const FftPlan *plan, double *re, double *im, size_t count);
+
+// ============================================
+// PSD (Welch)
+// ============================================
+
+typedef struct
+{
+    size_t nfft;         // Puntos por segmento
+    size_t n_bins;       // nfft/2 + 1 bins (espectro unilateral)
+    double *psd;         // Fracción de potencia por bin (suma = 1)
+    double bin_width;    // Ancho de un bin en múltiplos de la tasa de bits Rb
+    size_t segments;     // Segmentos promediados
+    double null_bw;      // Primer nulo tras el lóbulo principal (× Rb)
+    double dc_fraction;  // Fracción de la potencia en |f| <= PSD_DC_BAND
+} PsdResult;
+
+// Banda considerada "DC" (en múltiplos de Rb)
+#define PSD_DC_BAND 0.02
+
+/**
+ * @brief Estima la PSD de un esquema con Welch sobre bits aleatorios
+ * @param encode Codificador del esquema (ej: encode_nrz)
+ * @param n_bits Bits de información a simular (admite ~10^8)
+ * @param bit_multiple La longitud de cada trozo será múltiplo de este valor (4 para 4B/5B)
+ * @param sps Muestras por símbolo codificado (pulso rectangular)
+ * @param nfft Puntos por segmento (potencia de 2)
+ * @param seed Semilla del generador de bits
+ * @param out Resultado (liberar con psd_free)
+ * @return 0 si tuvo éxito, -1 si hubo error
+ */
+int psd_welch(encode_ptr encode, size_t n_bits, size_t bit_multiple, unsigned sps,
+              size_t nfft, uint64_t seed, PsdResult *out);
+
+/**
+ * @brief Libera la memoria de un PsdResult
+ */
+void psd_free(PsdResult *result);
+
+#endif // SPECTRUM_H
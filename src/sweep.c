@@ -0,0 +1,384 @@
+#define _POSIX_C_SOURCE 200809L
+#include "sweep.h"
+#include "crc32.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+
+#define SWEEP_MAGIC "LCSWEEP1"
+#define SWEEP_MAGIC_LEN 8
+
+// ============================================
+// Configuración
+// ============================================
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len)
+{
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    return h;
+}
+
+static uint64_t sweep_hash(const Sweep *sw)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    h = fnv1a(h, sw->bitstream, sw->len);
+    h = fnv1a(h, &sw->trials, sizeof(sw->trials));
+    h = fnv1a(h, &sw->seed, sizeof(sw->seed));
+    h = fnv1a(h, &sw->block, sizeof(sw->block));
+    for (size_t i = 0; i < sw->n_points; i++)
+    {
+        h = fnv1a(h, sw->points[i].codec->name, strlen(sw->points[i].codec->name) + 1);
+        h = fnv1a(h, &sw->points[i].ber, sizeof(double));
+    }
+    return h;
+}
+
+/**
+ * Deja todos los puntos sin ensayos (acumuladores vacíos)
+ */
+static int sweep_reset(Sweep *sw)
+{
+    for (size_t i = 0; i < sw->n_points; i++)
+    {
+        error_stats_free(&sw->points[i].stats);
+        sw->points[i].next_trial = 0;
+        if (error_stats_init(&sw->points[i].stats, sw->len, sw->len) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+int sweep_init(Sweep *sw, const char *bitstream, const LineCodec *const *codecs, size_t n_codecs,
+               const double *bers, size_t n_bers, uint64_t trials, uint64_t seed, uint64_t block,
+               unsigned nthreads)
+{
+    if (!sw || !bitstream || !codecs || !bers || n_codecs == 0 || n_bers == 0 || trials == 0)
+        return -1;
+    memset(sw, 0, sizeof(*sw));
+
+    sw->len = strlen(bitstream);
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        if (!codecs[c] || sw->len == 0 || sw->len % codecs[c]->in_block != 0)
+        {
+            fprintf(stderr, "Error: el mensaje del barrido no es múltiplo del bloque de %s\n",
+                    codecs[c] ? codecs[c]->name : "(nulo)");
+            return -1;
+        }
+    }
+
+    if (nthreads == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (online > 0) ? (unsigned)online : 1;
+    }
+
+    sw->bitstream = bitstream;
+    sw->trials = trials;
+    sw->seed = seed;
+    sw->block = (block == 0 || block > INT_MAX) ? INT_MAX : block;
+    sw->nthreads = nthreads;
+    sw->n_bers = n_bers;
+    sw->n_points = n_codecs * n_bers;
+    sw->points = calloc(sw->n_points, sizeof(SweepPoint));
+    if (!sw->points)
+        return -1;
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        for (size_t b = 0; b < n_bers; b++)
+        {
+            sw->points[c * n_bers + b].codec = codecs[c];
+            sw->points[c * n_bers + b].ber = bers[b];
+        }
+    }
+    if (sweep_reset(sw) != 0)
+    {
+        sweep_free(sw);
+        return -1;
+    }
+
+    sw->hash = sweep_hash(sw);
+    return 0;
+}
+
+const SweepPoint *sweep_point(const Sweep *sw, size_t codec_index, size_t ber_index)
+{
+    size_t i = codec_index * sw->n_bers + ber_index;
+    return (sw && ber_index < sw->n_bers && i < sw->n_points) ? &sw->points[i] : NULL;
+}
+
+void sweep_free(Sweep *sw)
+{
+    if (!sw || !sw->points)
+        return;
+    for (size_t i = 0; i < sw->n_points; i++)
+        error_stats_free(&sw->points[i].stats);
+    free(sw->points);
+    sw->points = NULL;
+}
+
+// ============================================
+// Serialización
+// ============================================
+
+typedef struct
+{
+    unsigned char *data;
+    size_t len, cap;
+    size_t pos;  // Cursor de lectura
+    int bad;     // Lectura fuera de rango
+} ByteBuf;
+
+static void buf_put(ByteBuf *b, const void *src, size_t n)
+{
+    if (b->len + n > b->cap)
+    {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->len + n)
+            cap *= 2;
+        unsigned char *data = realloc(b->data, cap);
+        if (!data)
+        {
+            b->bad = 1;
+            return;
+        }
+        b->data = data;
+        b->cap = cap;
+    }
+    memcpy(b->data + b->len, src, n);
+    b->len += n;
+}
+
+static void buf_get(ByteBuf *b, void *dst, size_t n)
+{
+    if (b->bad || n > b->len - b->pos)
+    {
+        b->bad = 1;
+        memset(dst, 0, n);
+        return;
+    }
+    memcpy(dst, b->data + b->pos, n);
+    b->pos += n;
+}
+
+static void put_u64(ByteBuf *b, uint64_t v)
+{
+    buf_put(b, &v, sizeof(v));
+}
+
+static uint64_t get_u64(ByteBuf *b)
+{
+    uint64_t v;
+    buf_get(b, &v, sizeof(v));
+    return v;
+}
+
+int sweep_save(const Sweep *sw, const char *path)
+{
+    if (!sw || !path)
+        return -1;
+
+    ByteBuf b = {0};
+    buf_put(&b, SWEEP_MAGIC, SWEEP_MAGIC_LEN);
+    put_u64(&b, sw->hash);
+    put_u64(&b, sw->n_points);
+
+    for (size_t i = 0; i < sw->n_points; i++)
+    {
+        const SweepPoint *p = &sw->points[i];
+        const ErrorStats *s = &p->stats;
+        // Posición del flujo del próximo ensayo (Rng.state antes de rng_seed)
+        put_u64(&b, p->next_trial);
+        put_u64(&b, sw->seed + p->next_trial);
+
+        put_u64(&b, s->trials);
+        buf_put(&b, &s->mean, sizeof(double));
+        buf_put(&b, &s->m2, sizeof(double));
+        int32_t extremes[2] = {s->min, s->max};
+        buf_put(&b, extremes, sizeof(extremes));
+        put_u64(&b, s->bursts);
+        put_u64(&b, s->failed);
+        put_u64(&b, s->lost_symbols);
+        put_u64(&b, s->flips);
+
+        // Histograma hasta el máximo observado; mapa solo si hay ensayos
+        uint64_t hist_used = s->trials ? (uint64_t)s->max + 1 : 0;
+        uint64_t heat_used = s->trials ? s->n_pos : 0;
+        put_u64(&b, hist_used);
+        for (uint64_t k = 0; k < hist_used; k++)
+            put_u64(&b, s->hist[k]);
+        put_u64(&b, heat_used);
+        for (uint64_t k = 0; k < heat_used; k++)
+            put_u64(&b, s->heat[k]);
+    }
+
+    uint32_t crc = crc32_compute(b.data, b.len);
+    buf_put(&b, &crc, sizeof(crc));
+    if (b.bad)
+    {
+        free(b.data);
+        return -1;
+    }
+
+    // Escritura atómica: temporal + rename
+    size_t tmp_len = strlen(path) + 5;
+    char *tmp = safe_malloc(tmp_len);
+    snprintf(tmp, tmp_len, "%s.tmp", path);
+
+    int status = -1;
+    FILE *f = fopen(tmp, "wb");
+    if (f)
+    {
+        int ok = (fwrite(b.data, 1, b.len, f) == b.len);
+        ok &= (fclose(f) == 0);
+        if (ok && rename(tmp, path) == 0)
+            status = 0;
+        else
+            remove(tmp);
+    }
+    if (status != 0)
+        fprintf(stderr, "Error: no se pudo escribir el checkpoint %s\n", path);
+
+    free(tmp);
+    free(b.data);
+    return status;
+}
+
+/**
+ * Lee el estado de un punto; devuelve -1 si no es coherente con el barrido
+ */
+static int load_point(ByteBuf *b, const Sweep *sw, SweepPoint *p)
+{
+    ErrorStats *s = &p->stats;
+    memset(s->hist, 0, (s->max_errors + 1) * sizeof(size_t));
+    memset(s->heat, 0, s->n_pos * sizeof(size_t));
+
+    p->next_trial = get_u64(b);
+    uint64_t position = get_u64(b);
+    s->trials = get_u64(b);
+    buf_get(b, &s->mean, sizeof(double));
+    buf_get(b, &s->m2, sizeof(double));
+    int32_t extremes[2];
+    buf_get(b, extremes, sizeof(extremes));
+    s->min = extremes[0];
+    s->max = extremes[1];
+    s->bursts = get_u64(b);
+    s->failed = get_u64(b);
+    s->lost_symbols = get_u64(b);
+    s->flips = get_u64(b);
+
+    if (b->bad || p->next_trial > sw->trials || s->trials != p->next_trial ||
+        position != sw->seed + p->next_trial)
+        return -1;
+
+    uint64_t hist_used = get_u64(b);
+    if (hist_used > s->max_errors + 1)
+        return -1;
+    for (uint64_t k = 0; k < hist_used; k++)
+        s->hist[k] = get_u64(b);
+
+    uint64_t heat_used = get_u64(b);
+    if (heat_used != 0 && heat_used != s->n_pos)
+        return -1;
+    for (uint64_t k = 0; k < heat_used; k++)
+        s->heat[k] = get_u64(b);
+
+    return b->bad ? -1 : 0;
+}
+
+int sweep_load(Sweep *sw, const char *path)
+{
+    if (!sw || !path)
+        return -1;
+
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return 0;
+
+    ByteBuf b = {0};
+    unsigned char chunk[1 << 14];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        buf_put(&b, chunk, n);
+    fclose(f);
+
+    int status = -1;
+    uint32_t crc;
+    if (!b.bad && b.len >= SWEEP_MAGIC_LEN + 2 * sizeof(uint64_t) + sizeof(crc))
+    {
+        b.len -= sizeof(crc);
+        memcpy(&crc, b.data + b.len, sizeof(crc));
+
+        char magic[SWEEP_MAGIC_LEN];
+        buf_get(&b, magic, SWEEP_MAGIC_LEN);
+        uint64_t hash = get_u64(&b);
+        uint64_t n_points = get_u64(&b);
+
+        if (crc == crc32_compute(b.data, b.len) && memcmp(magic, SWEEP_MAGIC, SWEEP_MAGIC_LEN) == 0 &&
+            hash == sw->hash && n_points == sw->n_points)
+        {
+            status = 0;
+            for (size_t i = 0; i < sw->n_points && status == 0; i++)
+                status = load_point(&b, sw, &sw->points[i]);
+            if (status == 0 && b.pos != b.len)
+                status = -1;
+        }
+    }
+    free(b.data);
+
+    if (status != 0)
+    {
+        sweep_reset(sw);
+        return -1;
+    }
+    return 1;
+}
+
+// ============================================
+// Ejecución
+// ============================================
+
+int sweep_run(Sweep *sw, const char *checkpoint, uint64_t max_blocks)
+{
+    if (!sw || !sw->points)
+        return -1;
+
+    if (checkpoint && sweep_load(sw, checkpoint) < 0)
+        fprintf(stderr, "Aviso: checkpoint %s dañado o de otro barrido; se empieza de cero\n", checkpoint);
+
+    uint64_t blocks = 0;
+    for (size_t i = 0; i < sw->n_points; i++)
+    {
+        SweepPoint *p = &sw->points[i];
+        while (p->next_trial < sw->trials)
+        {
+            if (max_blocks > 0 && blocks == max_blocks)
+                return 1;
+
+            uint64_t count = sw->trials - p->next_trial;
+            if (count > sw->block)
+                count = sw->block;
+
+            // El ensayo t del punto usa la semilla seed + t: un bloque empieza en seed + next_trial
+            ErrorStats part;
+            if (error_sweep(p->codec, sw->bitstream, p->ber, (int)count, sw->seed + p->next_trial,
+                            sw->nthreads, &part) != 0)
+                return -1;
+            error_stats_merge(&p->stats, &part);
+            error_stats_from_hist(&p->stats);
+            error_stats_free(&part);
+            p->next_trial += count;
+            blocks++;
+
+            if (checkpoint && sweep_save(sw, checkpoint) != 0)
+                return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+/**
+ * @file sweep.h
+ * @brief Barrido de BER por esquemas con puntos de control (checkpoint/resume)
+ *
+ * Un barrido es el producto esquemas × BER; cada punto acumula sus ensayos
+ * en un ErrorStats. Los ensayos se procesan en bloques de tamaño fijo y,
+ * tras cada bloque, el estado completo (acumuladores y posición del flujo
+ * aleatorio de cada punto) se guarda en un archivo binario compacto.
+ *
+ * Al reanudar, los puntos terminados no se recalculan y los demás siguen
+ * desde el primer ensayo pendiente. Como el ensayo t usa la semilla
+ * seed + t y los momentos se recalculan del histograma (exacto), el
+ * resultado final es idéntico bit a bit al de una ejecución sin cortes,
+ * aunque se reanude en una máquina con otro número de núcleos.
+ *
+ * Formato (orden de bytes nativo): "LCSWEEP1", huella de la configuración,
+ * número de puntos, por punto el ensayo siguiente, la posición del flujo y
+ * el acumulador, y al final un CRC-32 de todo lo anterior. Se escribe en
+ * un archivo temporal y se renombra, así que un corte a mitad de escritura
+ * deja intacto el checkpoint anterior.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codec.h"
+#include "errstats.h"
+
+typedef struct
+{
+    const LineCodec *codec;
+    double ber;
+    uint64_t next_trial;  // Ensayos ya acumulados (el siguiente usa seed + next_trial)
+    ErrorStats stats;
+} SweepPoint;
+
+typedef struct
+{
+    const char *bitstream;
+    size_t len;
+    uint64_t trials;      // Ensayos por punto
+    uint64_t seed;
+    uint64_t block;       // Ensayos entre checkpoints
+    unsigned nthreads;    // No entra en la huella: el resultado no depende de él
+    uint64_t hash;        // Huella de la configuración (valida el checkpoint)
+    SweepPoint *points;   // Orden: esquema mayor, BER menor
+    size_t n_points;
+    size_t n_bers;
+} Sweep;
+
+/**
+ * @brief Prepara un barrido esquemas × BER
+ * @param bitstream Mensaje (longitud múltiplo del bloque de todos los esquemas)
+ * @param codecs Esquemas
+ * @param n_codecs Número de esquemas
+ * @param bers Probabilidades de inversión por símbolo
+ * @param n_bers Número de valores de BER
+ * @param trials Ensayos por punto
+ * @param seed Semilla base
+ * @param block Ensayos por bloque (granularidad del checkpoint)
+ * @param nthreads Hilos por bloque (0: tantos como núcleos; no forma parte de la configuración)
+ * @return 0 si tuvo éxito, -1 si hubo error
+ */
+int sweep_init(Sweep *sw, const char *bitstream, const LineCodec *const *codecs, size_t n_codecs,
+               const double *bers, size_t n_bers, uint64_t trials, uint64_t seed, uint64_t block,
+               unsigned nthreads);
+
+/**
+ * @brief Ejecuta (o reanuda) el barrido
+ *
+ * Si checkpoint existe y corresponde a esta configuración, se parte de él;
+ * si no corresponde o está dañado, se avisa y se empieza de cero.
+ *
+ * @param checkpoint Ruta del archivo de estado (NULL: sin checkpoints)
+ * @param max_blocks Bloques a procesar en esta llamada (0: hasta terminar)
+ * @return 0 si el barrido terminó, 1 si se agotó max_blocks antes, -1 si hubo error
+ */
+int sweep_run(Sweep *sw, const char *checkpoint, uint64_t max_blocks);
+
+/**
+ * @brief Guarda el estado actual del barrido
+ * @return 0 si tuvo éxito, -1 si hubo error
+ */
+int sweep_save(const Sweep *sw, const char *path);
+
+/**
+ * @brief Carga un checkpoint sobre el barrido
+ * @return 1 si se cargó, 0 si el archivo no existe, -1 si no corresponde o está dañado
+ */
+int sweep_load(Sweep *sw, const char *path);
+
+/**
+ * @brief Punto (esquema, BER) del barrido
+ */
+const SweepPoint *sweep_point(const Sweep *sw, size_t codec_index, size_t ber_index);
+
+void sweep_free(Sweep *sw);
+
+#endif // SWEEP_H
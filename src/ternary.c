@@ -0,0 +1,133 @@
+#include "ternary.h"
+#include <pthread.h>
+#include <string.h>
+
+// Codificación: byte de bits + polaridad → 8 niveles (16 bits) y nueva polaridad
+static uint16_t enc_tab[2][256];
+static uint8_t enc_next[2][256];
+
+// Decodificación: 4 niveles + polaridad esperada → bits 0-3: marcas,
+// bits 4-6: violaciones, bit 7: próxima polaridad esperada
+static uint8_t dec_tab[2][256];
+
+static pthread_once_t ternary_once = PTHREAD_ONCE_INIT;
+
+static void ternary_init(void)
+{
+    for (unsigned plus = 0; plus < 2; plus++)
+    {
+        for (unsigned v = 0; v < 256; v++)
+        {
+            unsigned p = plus;
+            uint16_t out = 0;
+            for (int k = 7; k >= 0; k--)
+            {
+                unsigned b = (v >> k) & 1;
+                unsigned code = b ? (p ? TERNARY_PLUS : TERNARY_MINUS) : TERNARY_ZERO;
+                out = (uint16_t)((out << 2) | code);
+                p ^= b;
+            }
+            enc_tab[plus][v] = out;
+            enc_next[plus][v] = (uint8_t)p;
+
+            p = plus;
+            unsigned marks = 0, viol = 0;
+            for (int k = 3; k >= 0; k--)
+            {
+                unsigned code = (v >> (2 * k)) & 3;
+                unsigned mark = (code != TERNARY_ZERO);
+                marks = (marks << 1) | mark;
+                if (mark)
+                {
+                    unsigned is_plus = (code == TERNARY_PLUS);
+                    viol += (is_plus != p);
+                    p = !is_plus;
+                }
+            }
+            dec_tab[plus][v] = (uint8_t)(marks | (viol << 4) | (p << 7));
+        }
+    }
+}
+
+void ternary_context_init(TernaryContext *ctx, int pseudoternary)
+{
+    if (!ctx)
+        return;
+    ctx->pseudoternary = pseudoternary;
+    ctx->next_plus = 1;
+    ctx->violations = 0;
+}
+
+void ternary_encode_packed(TernaryContext *ctx, const uint8_t *bits, size_t nbits, uint8_t *levels)
+{
+    pthread_once(&ternary_once, ternary_init);
+
+    uint8_t invert = ctx->pseudoternary ? 0xFF : 0x00;
+    unsigned plus = ctx->next_plus;
+    size_t nbytes = (nbits + 7) / 8;
+
+    for (size_t i = 0; i < nbytes; i++)
+    {
+        uint8_t v = bits[i] ^ invert;
+
+        // Los bits de relleno del último byte no deben generar marcas
+        if (i == nbytes - 1 && nbits % 8 != 0)
+            v &= (uint8_t)(0xFF << (8 - nbits % 8));
+
+        uint16_t w = enc_tab[plus][v];
+        plus = enc_next[plus][v];
+        levels[2 * i] = (uint8_t)(w >> 8);
+        if (2 * i + 1 < (nbits + 3) / 4)
+            levels[2 * i + 1] = (uint8_t)w;
+    }
+
+    ctx->next_plus = plus;
+}
+
+void ternary_decode_packed(TernaryContext *ctx, const uint8_t *levels, size_t nlevels, uint8_t *bits)
+{
+    pthread_once(&ternary_once, ternary_init);
+
+    uint8_t invert = ctx->pseudoternary ? 0xFF : 0x00;
+    unsigned plus = ctx->next_plus;
+    size_t nbytes = (nlevels + 3) / 4;
+
+    memset(bits, 0, (nlevels + 7) / 8);
+
+    for (size_t i = 0; i < nbytes; i++)
+    {
+        uint8_t v = levels[i];
+        unsigned valid = 4;
+        if (i == nbytes - 1 && nlevels % 4 != 0)
+        {
+            valid = nlevels % 4;
+            v &= (uint8_t)(0xFF << (8 - 2 * valid)); // Relleno = ceros
+        }
+
+        uint8_t e = dec_tab[plus][v];
+        plus = e >> 7;
+        ctx->violations += (e >> 4) & 7;
+
+        unsigned nibble = e & 0xF;
+        bits[i / 2] |= (uint8_t)((i % 2 == 0) ? nibble << 4 : nibble);
+    }
+
+    // Pseudoternario: un cero de línea es un '1'
+    if (invert)
+    {
+        for (size_t i = 0; i < (nlevels + 7) / 8; i++)
+            bits[i] ^= invert;
+        if (nlevels % 8 != 0)
+            bits[nlevels / 8] &= (uint8_t)(0xFF << (8 - nlevels % 8));
+    }
+
+    ctx->next_plus = plus;
+}
+
+void ternary_unpack_levels(const uint8_t *levels, size_t nlevels, char *out)
+{
+    static const char symbol[4] = {'0', '+', '?', '-'};
+
+    for (size_t i = 0; i < nlevels; i++)
+        out[i] = symbol[(levels[i / 4] >> (6 - 2 * (i % 4))) & 3];
+}
@@ -0,0 +1,60 @@
+#ifndef TERNARY_H
+#define TERNARY_H
+
+/**
+ * @file ternary.h
+ * @brief Señales ternarias empaquetadas a 2 bits por nivel
+ *
+ * Cada byte guarda 4 niveles, el primero en los bits 7-6:
+ *   00 = cero, 01 = marca positiva, 11 = marca negativa (10 no se usa).
+ * La codificación es la misma que la de cualquier señal de 3 niveles
+ * (AMI, pseudoternario, MLT-3), así que sirve para futuros esquemas.
+ *
+ * AMI y pseudoternario se codifican por tablas (un byte de bits → 8
+ * niveles) sin saltos condicionales; la polaridad de la próxima marca y
+ * las violaciones bipolares se arrastran en un contexto de streaming.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TERNARY_ZERO 0x0
+#define TERNARY_PLUS 0x1
+#define TERNARY_MINUS 0x3
+
+typedef struct
+{
+    int pseudoternary;  // 0: AMI (los '1' son marcas); 1: pseudoternario (los '0')
+    unsigned next_plus; // 1 si la próxima marca es positiva
+    size_t violations;  // Marcas consecutivas de igual polaridad (al decodificar)
+} TernaryContext;
+
+/**
+ * @brief Inicializa un contexto (la primera marca será positiva)
+ */
+void ternary_context_init(TernaryContext *ctx, int pseudoternary);
+
+/**
+ * @brief Codifica bits empaquetados (primer bit en el MSB) a niveles de 2 bits
+ * @param ctx Contexto del flujo
+ * @param bits Bits de entrada
+ * @param nbits Número de bits (múltiplo de 8 salvo en el último trozo)
+ * @param levels Salida: (nbits + 3) / 4 bytes
+ */
+void ternary_encode_packed(TernaryContext *ctx, const uint8_t *bits, size_t nbits, uint8_t *levels);
+
+/**
+ * @brief Decodifica niveles de 2 bits a bits empaquetados
+ * @param ctx Contexto del flujo (acumula violaciones bipolares)
+ * @param levels Niveles de entrada
+ * @param nlevels Número de niveles (múltiplo de 8 salvo en el último trozo)
+ * @param bits Salida: (nlevels + 7) / 8 bytes
+ */
+void ternary_decode_packed(TernaryContext *ctx, const uint8_t *levels, size_t nlevels, uint8_t *bits);
+
+/**
+ * @brief Convierte niveles empaquetados a texto ('+', '-', '0')
+ */
+void ternary_unpack_levels(const uint8_t *levels, size_t nlevels, char *out);
+
+#endif // TERNARY_H
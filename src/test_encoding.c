@@ -1,10 +1,30 @@
 #include "encoding.h"
 #include "analysis.h"
+#include "spectrum.h"
+#include "batch.h"
+#include "parallel.h"
+#include "bitslice.h"
+#include "importance.h"
+#include "crn.h"
+#include "crc32.h"
+#include "framing.h"
+#include "fec.h"
+#include "interleave.h"
+#include "ternary.h"
+#include "blockcode.h"
+#include "arena.h"
+#include "bitpack.h"
+#include "errstats.h"
+#include "sweep.h"
+#include "pipeline.h"
+#include "utils.h"
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <math.h>
+#include <pthread.h>
 
 // Función auxiliar para comparar strings de bits
 void test_equal(const char *test_name, const char *expected, const char *actual)
@@ -21,15 +41,58 @@ void test_equal(const char *test_name, const char *expected, const char *actual)
     }
 }
 
+// Función auxiliar para comprobar una condición
+void test_true(const char *test_name, int condition)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "❌ %s falló.\n", test_name);
+        exit(1);
+    }
+    else
+    {
+        printf("✅ %s pasó.\n", test_name);
+    }
+}
+
+// CRC-32 de referencia, un bit a la vez (polinomio reflejado 0xEDB88320)
+static uint32_t crc32_bitwise(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+typedef struct
+{
+    Report *report;
+    unsigned shard;
+} ShardArg;
+
+static void *add_shard_rows(void *arg)
+{
+    ShardArg *a = arg;
+    for (int i = 0; i < 100; i++)
+        report_row(a->report, a->shard, "%u\t%d", a->shard, i);
+    return NULL;
+}
+
 int main(void)
 {
 
-    FILE *f_init = fopen("results/signals.txt", "w");
-    if (f_init)
+    // Un solo handle para todos los diagramas
+    FILE *signals = fopen("results/signals.txt", "w");
+    if (!signals)
     {
-        fprintf(f_init, "=== REPORTE DE SEÑALES GENERADO AUTOMÁTICAMENTE ===\n");
-        fclose(f_init);
+        fprintf(stderr, "No se pudo crear results/signals.txt\n");
+        return 1;
     }
+    fprintf(signals, "=== REPORTE DE SEÑALES GENERADO AUTOMÁTICAMENTE ===\n");
 
     printf("=== Iniciando pruebas automáticas de codificación ===\n");
 
@@ -45,7 +108,7 @@ int main(void)
     char *dec_nrz = decode_nrz(enc_nrz);
     test_equal("NRZ encode/decode", bitstream, dec_nrz);
     add_noise(enc_nrz, ber);
-    plot_signal(enc_nrz, "results/signals.txt");
+    plot_signal_to(signals, enc_nrz);
     free(enc_nrz);
     free(dec_nrz);
 
@@ -54,7 +117,7 @@ int main(void)
     char *dec_nrzi = decode_nrzi(enc_nrzi);
     test_equal("NRZI encode/decode", bitstream, dec_nrzi);
     add_noise(enc_nrzi, ber);
-    plot_signal(enc_nrzi, "results/signals.txt");
+    plot_signal_to(signals, enc_nrzi);
     free(enc_nrzi);
     free(dec_nrzi);
 
@@ -63,7 +126,7 @@ int main(void)
     char *dec_man = decode_manchester(enc_man);
     test_equal("Manchester encode/decode", bitstream, dec_man);
     add_noise(enc_man, ber);
-    plot_signal(enc_man, "results/signals.txt");
+    plot_signal_to(signals, enc_man);
     free(enc_man);
     free(dec_man);
 
@@ -73,10 +136,524 @@ int main(void)
     char *dec_4b5b = decode_4b5b(enc_4b5b);
     test_equal("4B/5B encode/decode", bitstream_4b, dec_4b5b);
     add_noise(enc_4b5b, ber);
-    plot_signal(enc_4b5b, "results/signals.txt");
+    plot_signal_to(signals, enc_4b5b);
     free(enc_4b5b);
     free(dec_4b5b);
 
+    // Lotes: misma salida que las funciones individuales, trama inválida marcada
+    BitMessage frames[3] = {{"1100", 4}, {"10101111", 8}, {"101", 3}};
+    size_t offsets[4];
+    int frame_status[3];
+    const LineCodec *c4b5b = codec_find("4B/5B");
+    char *arena = malloc(batch_output_size(c4b5b, frames, 3, 0));
+    long bad = batch_encode(c4b5b, frames, 3, arena, batch_output_size(c4b5b, frames, 3, 0),
+                            offsets, frame_status, 1);
+    char *ref = encode_4b5b("10101111");
+    test_true("Lote 4B/5B", bad == 1 && frame_status[2] == -1 && offsets[2] - offsets[1] == 10 &&
+                                memcmp(arena + offsets[1], ref, 10) == 0);
+    free(ref);
+    free(arena);
+
+    // Flujo único repartido entre hilos: idéntico a la versión secuencial
+    size_t par_len = (size_t)PARALLEL_MIN_BYTES * 2;
+    char *par_bits = generate_random_bits(par_len);
+    char *par_enc = malloc(par_len * 2);
+    char *par_dec = malloc(par_len);
+    size_t n_codecs;
+    const LineCodec *codecs = codec_registry(&n_codecs);
+    int par_ok = 1;
+    for (size_t i = 0; i < n_codecs; i++)
+    {
+        const LineCodec *c = &codecs[i];
+        size_t enc_len = par_len / c->in_block * c->out_block;
+        char *serial = c->encode(par_bits);
+        par_ok &= parallel_encode(c, par_bits, par_len, par_enc, 4) == 0 &&
+                  memcmp(serial, par_enc, enc_len) == 0 &&
+                  parallel_decode(c, par_enc, enc_len, par_dec, 4) == 0 &&
+                  memcmp(par_bits, par_dec, par_len) == 0;
+        free(serial);
+    }
+    test_true("Codificación paralela de un flujo", par_ok);
+    free(par_bits);
+    free(par_enc);
+    free(par_dec);
+
+    // Bit-sliced: casos deterministas con BER 0 y BER 1
+    int slice_err[70];
+    bitslice_simulate("110010", 0.0, 70, "NRZ", 1, slice_err);
+    test_true("Bit-sliced NRZ sin ruido", slice_err[0] == 0 && slice_err[69] == 0);
+    bitslice_simulate("110010", 1.0, 70, "NRZI", 1, slice_err);
+    test_true("Bit-sliced NRZI con BER 1", slice_err[0] == 1 && slice_err[69] == 1);
+    bitslice_simulate("110010", 1.0, 70, "Manchester", 1, slice_err);
+    test_true("Bit-sliced Manchester con BER 1", slice_err[0] == 6 && slice_err[69] == 6);
+
+    // Muestreo de importancia: BER decodificado ≈ p (NRZ) y ≈ 2p (NRZI) con p = 1e-9
+    char *is_bits = generate_random_bits(1000);
+    ISResult is_nrz, is_nrzi;
+    importance_estimate(codec_find("NRZ"), is_bits, 1e-9, 0, 2000, 3, &is_nrz);
+    importance_estimate(codec_find("NRZI"), is_bits, 1e-9, 0, 2000, 4, &is_nrzi);
+    test_true("Importancia NRZ", fabs(is_nrz.estimate / 1e-9 - 1.0) < 0.15);
+    test_true("Importancia NRZI", fabs(is_nrzi.estimate / 2e-9 - 1.0) < 0.15);
+    free(is_bits);
+
+    // CRN: la diferencia pareada NRZI - NRZ es positiva y más precisa que con ruido independiente
+    char *crn_bits = generate_random_bits(1000);
+    CrnResult crn[8];
+    int n_crn = crn_compare(crn_bits, 0.01, 200, 5, crn, 8);
+    test_true("CRN NRZI vs NRZ", n_crn >= 2 && crn[1].diff_mean > 0 && crn[1].diff_ci < crn[1].indep_ci);
+    free(crn_bits);
+
+    // CRC-32: vector estándar
+    test_true("CRC-32 de 123456789", crc32_compute("123456789", 9) == 0xCBF43926u);
+
+    // Contra la referencia bit a bit: desde 64 bytes entra el plegado PCLMULQDQ (si la CPU lo
+    // admite), con inicios desalineados y encadenando llamadas a través del bloque de 64
+    uint8_t crc_buf[308];
+    uint32_t crc_state = 2463534242u;
+    for (size_t i = 0; i < sizeof(crc_buf); i++)
+    {
+        crc_state ^= crc_state << 13;
+        crc_state ^= crc_state >> 17;
+        crc_state ^= crc_state << 5;
+        crc_buf[i] = (uint8_t)crc_state;
+    }
+    int crc_ok = 1;
+    for (size_t off = 0; off < 8; off++)
+        for (size_t n = 0; n <= 300; n++)
+            crc_ok &= crc32_compute(crc_buf + off, n) == crc32_bitwise(crc_buf + off, n);
+    test_true(crc32_has_clmul() ? "CRC-32 PCLMULQDQ vs referencia" : "CRC-32 slice-by-8 vs referencia", crc_ok);
+
+    int chain_ok = 1;
+    static const size_t crc_splits[][2] = {{40, 100}, {63, 65}, {64, 64}, {100, 200}, {1, 299}};
+    for (size_t k = 0; k < sizeof(crc_splits) / sizeof(crc_splits[0]); k++)
+    {
+        size_t a = crc_splits[k][0], b = crc_splits[k][1];
+        uint32_t chained = crc32_update(crc32_update(0, crc_buf + 3, a), crc_buf + 3 + a, b);
+        chain_ok &= chained == crc32_bitwise(crc_buf + 3, a + b);
+    }
+    test_true("CRC-32 encadenado", chain_ok);
+
+    // Entramado: una trama alterada no pasa la verificación
+    char *framed = frame_encode("10101111000011001010", 8);
+    test_true("Entramado CRC-32", strlen(framed) == framed_length(20, 8) && frame_crc_ok(framed, 8) &&
+                                      frame_crc_ok(framed + 80, 4));
+    framed[3] = (framed[3] == '0') ? '1' : '0';
+    test_true("CRC-32 detecta error", !frame_crc_ok(framed, 8));
+    free(framed);
+
+    // Manchester diferencial: tras una trama que no decodifica, el receptor toma el último
+    // medio nivel recibido y la trama siguiente pasa su CRC
+    const LineCodec *dm = codec_find("Manchester Diferencial");
+    char dm_bits[193];
+    for (int i = 0; i < 192; i++)
+        dm_bits[i] = "0110100111"[i % 10];
+    dm_bits[192] = '\0';
+    char *dm_framed = frame_encode(dm_bits, 64);
+    size_t dm_len = strlen(dm_framed), dm_frame_sym = 2 * (64 + FRAME_CRC_BITS);
+    char *dm_sym = malloc(2 * dm_len);
+    LineState dm_st;
+    line_state_init(&dm_st);
+    dm->encode_block(dm_framed, dm_len, dm_sym, &dm_st);
+    dm_sym[dm_frame_sym + 81] = dm_sym[dm_frame_sym + 80]; // Par sin transición en la trama 1
+    FrameStats dm_stats = {0};
+    frame_receive(dm, dm_framed, dm_sym, 64, &dm_stats);
+    // La trama 1 termina en medio nivel '1': un receptor que reinicia a 0 fallaría la trama 2
+    test_true("Entramado Manchester diferencial resincroniza",
+              dm_sym[2 * dm_frame_sym - 1] == '1' && dm_stats.frames == 3 && dm_stats.errored == 1 &&
+                  dm_stats.detected == 1 && dm_stats.undetected == 0);
+    free(dm_framed);
+    free(dm_sym);
+
+    // FEC: un error por bloque se corrige, dos errores SECDED se detectan
+    FecStats fec_stats = {0};
+    char *fec_bits = generate_random_bits(128);
+    char *ham = fec_encode(fec_bits, FEC_HAMMING74);
+    ham[2] = (ham[2] == '0') ? '1' : '0';
+    ham[13] = (ham[13] == '0') ? '1' : '0';
+    char *ham_dec = fec_decode(ham, FEC_HAMMING74, &fec_stats);
+    test_equal("Hamming(7,4) corrige", fec_bits, ham_dec);
+    char *sec = fec_encode(fec_bits, FEC_SECDED7264);
+    sec[5] = (sec[5] == '0') ? '1' : '0';
+    sec[72 + 40] = (sec[72 + 40] == '0') ? '1' : '0';
+    sec[72 + 41] = (sec[72 + 41] == '0') ? '1' : '0';
+    char *sec_dec = fec_decode(sec, FEC_SECDED7264, &fec_stats);
+    test_true("SECDED(72,64) corrige y detecta", strncmp(fec_bits, sec_dec, 64) == 0 &&
+                                                    fec_stats.corrected == 3 && fec_stats.uncorrectable == 1);
+    free(fec_bits);
+    free(ham);
+    free(ham_dec);
+    free(sec);
+    free(sec_dec);
+
+    // FEC tras Manchester: un símbolo invertido deja un par inválido (borradura) y Hamming lo corrige
+    const LineCodec *fec_man = codec_find("Manchester");
+    char *fm_bits = generate_random_bits(64);
+    char *fm_prot = fec_encode(fm_bits, FEC_HAMMING74);
+    size_t fm_len = strlen(fm_prot);
+    char *fm_sym = malloc(2 * fm_len);
+    LineState fm_st;
+    line_state_init(&fm_st);
+    fec_man->encode_block(fm_prot, fm_len, fm_sym, &fm_st);
+    size_t fm_one = strcspn(fm_prot, "1"); // La borradura se lee como 0: se elige un bit en 1
+    fm_sym[2 * fm_one] = (fm_sym[2 * fm_one] == '0') ? '1' : '0';
+    FecStats fm_stats = {0};
+    size_t fm_erased = 0;
+    char *fm_dec = fec_line_decode(fec_man, fm_sym, 2 * fm_len, FEC_HAMMING74, &fm_stats, &fm_erased);
+    test_true("FEC corrige un símbolo Manchester", fm_dec && strcmp(fm_dec, fm_bits) == 0 && fm_erased == 1 &&
+                                                      fm_stats.corrected == 1);
+    free(fm_bits);
+    free(fm_prot);
+    free(fm_sym);
+    free(fm_dec);
+
+    // Entrelazado: por trozos da lo mismo que la transpuesta, y se deshace
+    const char *il_in = "ABCDEFGHIJKLmnopqrstuvwxyz";
+    char il_out[32], il_back[32];
+    BlockInterleaver bi_tx, bi_rx;
+    block_interleaver_init(&bi_tx, 3, 4, 0);
+    block_interleaver_init(&bi_rx, 3, 4, 1);
+    size_t il_w = block_interleaver_push(&bi_tx, il_in, 5, il_out);
+    il_w += block_interleaver_push(&bi_tx, il_in + 5, 21, il_out + il_w);
+    il_w += block_interleaver_flush(&bi_tx, il_out + il_w);
+    size_t il_r = block_interleaver_push(&bi_rx, il_out, il_w, il_back);
+    il_r += block_interleaver_flush(&bi_rx, il_back + il_r);
+    il_back[il_r] = '\0';
+    test_true("Entrelazado de bloque", il_w == 26 && strncmp(il_out, "AEIBFJCGKDHL", 12) == 0);
+    test_equal("Desentrelazado de bloque", il_in, il_back);
+    block_interleaver_free(&bi_tx);
+    block_interleaver_free(&bi_rx);
+
+    uint8_t bm[16] = {0x80, 0, 0x40, 0, 0x20, 0, 0x10, 0, 0x08, 0, 0x04, 0, 0x02, 0, 0x01, 0xFF};
+    uint8_t bt[16];
+    transpose_bits(bm, bt, 8, 16);
+    test_true("Transpuesta de bits 8x8", bt[0] == 0x80 && bt[3] == 0x10 && bt[7] == 0x01 && bt[8] == 0x01 &&
+                                           bt[15] == 0x01);
+
+    ConvInterleaver ci_tx, ci_rx;
+    char conv_tx[64], conv_rx[64];
+    conv_interleaver_init(&ci_tx, 3, 2, 0, '.');
+    conv_interleaver_init(&ci_rx, 3, 2, 1, '.');
+    memset(conv_tx, '.', sizeof(conv_tx));
+    conv_interleaver_push(&ci_tx, il_in, 26, conv_tx);
+    conv_interleaver_push(&ci_tx, conv_tx + 40, 12, conv_tx + 26);
+    conv_interleaver_push(&ci_rx, conv_tx, 38, conv_rx);
+    test_true("Entrelazado convolucional", conv_interleaver_delay(3, 2) == 12 &&
+                                               strncmp(conv_rx + 12, il_in, 26) == 0);
+    conv_interleaver_free(&ci_tx);
+    conv_interleaver_free(&ci_rx);
+
+    // PSD: el primer nulo de NRZ cae en Rb, el de Manchester en 2Rb
+    PsdResult psd_nrz, psd_man;
+    test_true("PSD NRZ", psd_welch(encode_nrz, 1 << 18, 1, 8, 1024, 1, &psd_nrz) == 0 &&
+                             psd_nrz.null_bw > 0.95 && psd_nrz.null_bw < 1.05);
+    test_true("PSD Manchester", psd_welch(encode_manchester, 1 << 18, 1, 8, 1024, 2, &psd_man) == 0 &&
+                                    psd_man.null_bw > 1.9 && psd_man.null_bw < 2.1 &&
+                                    psd_man.dc_fraction < psd_nrz.dc_fraction / 10);
+    psd_free(&psd_nrz);
+    psd_free(&psd_man);
+
+    // AMI, pseudoternario y Manchester diferencial
+    char *enc_ami = encode_ami(bitstream);
+    char *dec_ami = decode_ami(enc_ami);
+    test_equal("AMI encode", "+-00+0", enc_ami);
+    test_equal("AMI encode/decode", bitstream, dec_ami);
+    plot_signal_to(signals, enc_ami);
+    free(enc_ami);
+    free(dec_ami);
+
+    char *enc_pt = encode_pseudoternary(bitstream);
+    char *dec_pt = decode_pseudoternary(enc_pt);
+    test_equal("Pseudoternario encode", "00+-0+", enc_pt);
+    test_equal("Pseudoternario encode/decode", bitstream, dec_pt);
+    free(enc_pt);
+    free(dec_pt);
+
+    char *enc_dm = encode_diff_manchester(bitstream);
+    char *dec_dm = decode_diff_manchester(enc_dm);
+    test_equal("Manchester diferencial encode", "100101011010", enc_dm);
+    test_equal("Manchester diferencial encode/decode", bitstream, dec_dm);
+    plot_signal_to(signals, enc_dm);
+    free(enc_dm);
+    free(dec_dm);
+
+    // Ternario empaquetado: igual que la versión de texto, en dos trozos
+    const char *tern_bits = "1100101111010001";
+    uint8_t tern_in[2], tern_lv[4], tern_back[2];
+    char tern_txt[17];
+    pack_bitstream(tern_bits, 16, tern_in);
+    TernaryContext tctx;
+    ternary_context_init(&tctx, 0);
+    ternary_encode_packed(&tctx, tern_in, 8, tern_lv);
+    ternary_encode_packed(&tctx, tern_in + 1, 8, tern_lv + 2);
+    ternary_unpack_levels(tern_lv, 16, tern_txt);
+    tern_txt[16] = '\0';
+    char *tern_ref = encode_ami(tern_bits);
+    test_equal("AMI empaquetado", tern_ref, tern_txt);
+    ternary_context_init(&tctx, 0);
+    ternary_decode_packed(&tctx, tern_lv, 16, tern_back);
+    test_true("AMI empaquetado decode", tern_back[0] == tern_in[0] && tern_back[1] == tern_in[1] &&
+                                            tctx.violations == 0);
+    free(tern_ref);
+
+    // Motor mBnB: tabla 3B4B, validación, borraduras, streaming y empaquetado
+    const BlockCode *b34 = block_code_3b4b();
+    const BlockCode *b45 = block_code_4b5b();
+    char bc_out[16] = {0}, bc_back[16] = {0};
+    block_code_encode(b34, "000111", 6, bc_out);
+    test_equal("3B4B encode", "10111110", bc_out);
+    test_true("3B4B decode", block_code_decode(b34, bc_out, 8, bc_back) == 0 && memcmp(bc_back, "000111", 6) == 0);
+
+    BlockCode bc_bad;
+    BlockCodeEntry dup_table[] = {{"0", "01"}, {"1", "01"}};
+    test_true("Tabla mBnB con palabras duplicadas", block_code_init(&bc_bad, "1B2B", dup_table, 2) == -1);
+
+    BlockCodeStats bc_stats = {0};
+    block_code_decode_erasures(b45, "1111XX1110", 10, bc_back, &bc_stats);
+    test_true("4B/5B con borraduras", memcmp(bc_back, "0000XXXX", 8) == 0 && bc_stats.recovered == 1 &&
+                                          bc_stats.erased == 1);
+
+    BlockCodeStream bc_stream;
+    block_code_stream_init(&bc_stream, b34, 0);
+    long bc_first = block_code_stream_push(&bc_stream, "00", 2, bc_out);
+    long bc_rest = block_code_stream_push(&bc_stream, "0111", 4, bc_out);
+    test_true("3B4B por trozos", bc_first == 0 && bc_rest == 8 && memcmp(bc_out, "10111110", 8) == 0);
+
+    uint8_t bc_packed[2], bc_unpacked[1];
+    block_code_encode_packed(b45, (const uint8_t *)"\xA5", 8, bc_packed);
+    test_true("4B/5B empaquetado", bc_packed[0] == 0xB2 && bc_packed[1] == 0xC0 &&
+                                       block_code_decode_packed(b45, bc_packed, 10, bc_unpacked) == 0 &&
+                                       bc_unpacked[0] == 0xA5);
+
+    // Texto ↔ bits empaquetados (ruta vectorizada y resto escalar)
+    char bp_text[101], bp_back[101];
+    uint8_t bp_packed[13];
+    for (int i = 0; i < 100; i++)
+        bp_text[i] = (i % 3 == 0) ? 'H' : 'L';
+    bp_text[100] = '\0';
+    int bp_ok = bits_pack(bp_text, 100, bp_packed, 'L', 'H') == 0 && bp_packed[0] == 0x92;
+    bits_unpack(bp_packed, 100, bp_back, 'L', 'H');
+    bp_ok &= memcmp(bp_text, bp_back, 100) == 0;
+    bp_text[70] = '0';
+    bp_ok &= bits_validate(bp_text, 100, 'L', 'H') == 70 && bits_pack(bp_text, 100, bp_packed, 'L', 'H') == -1;
+    test_true("Empaquetado vectorizado", bp_ok && is_valid_bitstream("0110") && !is_valid_bitstream("01a0"));
+
+    // Cada ruta contra una referencia bit a bit: longitudes 0-300 cubren todos los restos tras
+    // los bloques de 32, 16 y 8 símbolos; '-'/'+' difieren en dos bits (solo ruta escalar)
+    static const char *const bk_kernels[] = {"AVX2", "SSE2", "SWAR"};
+    static const char bk_alpha[3][2] = {{'L', 'H'}, {'0', '1'}, {'-', '+'}};
+    char bk_text[301], bk_back[301];
+    uint8_t bk_packed[38], bk_ref[38];
+    uint32_t bk_state = 12345;
+    for (int k = 0; k < 3; k++)
+    {
+        char bk_name[64];
+        snprintf(bk_name, sizeof(bk_name), "Empaquetado ruta %s", bk_kernels[k]);
+        if (bits_force_kernel(bk_kernels[k]) != 0)
+        {
+            printf("⚠️  %s: la CPU no la admite.\n", bk_name);
+            continue;
+        }
+
+        int bk_ok = strcmp(bits_kernel_name(), bk_kernels[k]) == 0;
+        for (int a = 0; a < 3; a++)
+        {
+            char zero = bk_alpha[a][0], one = bk_alpha[a][1];
+            for (size_t n = 0; n <= 300; n++)
+            {
+                memset(bk_ref, 0, sizeof(bk_ref));
+                for (size_t i = 0; i < n; i++)
+                {
+                    bk_state = bk_state * 1103515245u + 12345u;
+                    int bit = (bk_state >> 16) & 1;
+                    bk_text[i] = bit ? one : zero;
+                    bk_ref[i / 8] |= (uint8_t)(bit << (7 - i % 8));
+                }
+
+                // Los bits de relleno del último byte deben quedar en cero
+                bk_ok &= bits_pack(bk_text, n, bk_packed, zero, one) == 0 &&
+                         memcmp(bk_packed, bk_ref, (n + 7) / 8) == 0;
+                bk_back[n] = '#';
+                bits_unpack(bk_ref, n, bk_back, zero, one);
+                bk_ok &= memcmp(bk_back, bk_text, n) == 0 && bk_back[n] == '#';
+                bk_ok &= bits_validate(bk_text, n, zero, one) == n;
+                if (n > 0)
+                {
+                    size_t bad = n * 5 / 7;
+                    bk_text[bad] = 'x';
+                    bk_ok &= bits_validate(bk_text, n, zero, one) == bad &&
+                             bits_pack(bk_text, n, bk_packed, zero, one) == -1;
+                }
+            }
+        }
+        test_true(bk_name, bk_ok);
+    }
+    bits_force_kernel(NULL);
+    test_true("Ruta de empaquetado inexistente", bits_force_kernel("NEON") == -1);
+
+    // Arena: tras el primer ensayo ya no se pide memoria al sistema
+    Arena trial_arena;
+    arena_init(&trial_arena, 64);
+    Arena *prev_arena = arena_set_current(&trial_arena);
+    size_t arena_mallocs = 0;
+    int arena_ok = 1;
+    for (int i = 0; i < 20; i++)
+    {
+        arena_reset(&trial_arena);
+        char *a_enc = encode_manchester("1100101011");
+        char *a_dec = decode_manchester(a_enc);
+        arena_ok &= arena_owns(&trial_arena, a_enc) && strcmp(a_dec, "1100101011") == 0;
+        current_free(a_dec); // No-op: pertenece a la arena
+        if (i == 1)
+            arena_mallocs = trial_arena.mallocs;
+    }
+    arena_set_current(prev_arena);
+    test_true("Arena sin malloc en régimen estable", arena_ok && trial_arena.mallocs == arena_mallocs);
+    arena_free(&trial_arena);
+
+    BufferPool pool;
+    pool_init(&pool, 100, 4);
+    void *pool_a = pool_get(&pool);
+    pool_put(&pool, pool_a);
+    void *pool_b = pool_get(&pool);
+    test_true("Pool recicla buffers", pool_a == pool_b && pool.mallocs == 1);
+    pool_put(&pool, pool_b);
+    pool_destroy(&pool);
+
+    // Histograma de errores: fusión de Chan igual a la acumulación secuencial
+    ErrorStats es_a, es_b;
+    error_stats_init(&es_a, 20, 0);
+    error_stats_init(&es_b, 20, 0);
+    error_stats_add(&es_a, 4);
+    error_stats_add(&es_a, 7);
+    error_stats_add(&es_b, 13);
+    error_stats_add(&es_b, 16);
+    error_stats_merge(&es_a, &es_b);
+    test_true("Fusión de histogramas (Chan)",
+              fabs(es_a.mean - 10) < 1e-12 && fabs(error_stats_stddev(&es_a) - sqrt(22.5)) < 1e-12 &&
+                  error_stats_percentile(&es_a, 0.5) == 7 && error_stats_percentile(&es_a, 0.99) == 16);
+    error_stats_free(&es_a);
+    error_stats_free(&es_b);
+
+    // Barrido por hilos: mismo resultado con 1 y 4 hilos; NRZI duplica los errores
+    char *es_bits = generate_random_bits(1000);
+    ErrorStats es_one, es_four, es_nrz;
+    error_sweep(codec_find("NRZI"), es_bits, 0.01, 1100, 7, 1, &es_one);
+    error_sweep(codec_find("NRZI"), es_bits, 0.01, 1100, 7, 4, &es_four);
+    error_sweep(codec_find("NRZ"), es_bits, 0.01, 1100, 7, 4, &es_nrz);
+    size_t es_wrong = 0, es_wrong_nrz = 0;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        es_wrong += es_one.heat[i];
+        es_wrong_nrz += es_nrz.heat[i];
+    }
+    test_true("Barrido de errores independiente de los hilos",
+              memcmp(es_one.hist, es_four.hist, 1001 * sizeof(size_t)) == 0 &&
+                  memcmp(es_one.heat, es_four.heat, 1000 * sizeof(size_t)) == 0 &&
+                  memcmp(&es_one.mean, &es_four.mean, sizeof(double)) == 0 &&
+                  memcmp(&es_one.m2, &es_four.m2, sizeof(double)) == 0);
+    test_true("Rachas de error NRZI vs NRZ", (double)es_wrong / es_one.bursts > 1.8 &&
+                                                 (double)es_wrong_nrz / es_nrz.bursts < 1.1);
+    error_stats_free(&es_one);
+    error_stats_free(&es_four);
+    error_stats_free(&es_nrz);
+    free(es_bits);
+
+    // Barrido con checkpoint: cortado tras 3 bloques y reanudado con otro número de hilos,
+    // idéntico a una pasada completa
+    char *sw_bits = generate_random_bits(400);
+    const LineCodec *sw_codecs[] = {codec_find("NRZI"), codec_find("4B/5B")};
+    double sw_bers[] = {0.005, 0.05};
+    Sweep sw_full, sw_cut, sw_resumed;
+    sweep_init(&sw_full, sw_bits, sw_codecs, 2, sw_bers, 2, 100, 11, 30, 2);
+    sweep_init(&sw_cut, sw_bits, sw_codecs, 2, sw_bers, 2, 100, 11, 30, 2);
+    sweep_init(&sw_resumed, sw_bits, sw_codecs, 2, sw_bers, 2, 100, 11, 30, 5);
+    remove("results/sweep_test.ckpt");
+    int sw_ok = sweep_run(&sw_full, NULL, 0) == 0 && sweep_run(&sw_cut, "results/sweep_test.ckpt", 3) == 1 &&
+                sweep_load(&sw_resumed, "results/sweep_test.ckpt") == 1 &&
+                sweep_run(&sw_resumed, "results/sweep_test.ckpt", 0) == 0;
+    for (size_t i = 0; sw_ok && i < sw_full.n_points; i++)
+    {
+        const ErrorStats *a = &sw_full.points[i].stats, *b = &sw_resumed.points[i].stats;
+        sw_ok = a->trials == 100 && b->trials == 100 && memcmp(&a->mean, &b->mean, sizeof(double)) == 0 &&
+                memcmp(&a->m2, &b->m2, sizeof(double)) == 0 &&
+                memcmp(a->hist, b->hist, 401 * sizeof(size_t)) == 0 &&
+                memcmp(a->heat, b->heat, 400 * sizeof(size_t)) == 0 && a->flips == b->flips;
+    }
+    test_true("Barrido reanudado desde checkpoint", sw_ok && sw_cut.points[0].next_trial == 90);
+    remove("results/sweep_test.ckpt");
+    sweep_free(&sw_full);
+    sweep_free(&sw_cut);
+    sweep_free(&sw_resumed);
+    free(sw_bits);
+
+    // Tubería: la misma pila en línea y con un hilo por etapa da los mismos bits
+    const LineCodec *pl_nrzi = codec_find("NRZI");
+    char *pl_inline = malloc(100000), *pl_threaded = malloc(100000);
+    size_t pl_len[2];
+    PipeErrors pl_err[2];
+    int pl_ok = 1;
+    for (int threaded = 0; threaded < 2; threaded++)
+    {
+        Pipeline *pl = pipeline_create(4096);
+        pl_ok &= pipeline_add_source(pl, 100000, 21) == 0 && pipeline_add_scrambler(pl, 0x5B) == 0 &&
+                 pipeline_add_block_encoder(pl, block_code_4b5b()) == 0 &&
+                 pipeline_add_line_encoder(pl, pl_nrzi) == 0 && pipeline_add_channel(pl, pl_nrzi, 0.001, 22) == 0 &&
+                 pipeline_add_line_decoder(pl, pl_nrzi) == 0 &&
+                 pipeline_add_block_decoder(pl, block_code_4b5b()) == 0 && pipeline_add_scrambler(pl, 0x5B) == 0 &&
+                 pipeline_add_error_counter(pl, &pl_err[threaded]) == 0 &&
+                 pipeline_add_collector(pl, threaded ? pl_threaded : pl_inline, 100000, &pl_len[threaded]) == 0 &&
+                 pipeline_run(pl, threaded) == 0;
+        pipeline_free(pl);
+    }
+    test_true("Tubería en línea y con hilos", pl_ok && pl_len[0] == 100000 && pl_len[1] == 100000 &&
+                                                  memcmp(pl_inline, pl_threaded, 100000) == 0 &&
+                                                  pl_err[0].errors == pl_err[1].errors && pl_err[0].errors > 0);
+    free(pl_inline);
+    free(pl_threaded);
+
+    // Sin ruido: cada esquema (en su lugar o con trozo nuevo) devuelve los bits enviados
+    int pl_clean = 1;
+    for (size_t i = 0; i < n_codecs; i++)
+    {
+        PipeErrors clean_err;
+        Pipeline *pl = pipeline_create(4096);
+        pl_clean &= pipeline_add_source(pl, 50000, 23) == 0 && pipeline_add_line_encoder(pl, &codecs[i]) == 0 &&
+                    pipeline_add_line_decoder(pl, &codecs[i]) == 0 &&
+                    pipeline_add_error_counter(pl, &clean_err) == 0 && pipeline_run(pl, 1) == 0 &&
+                    clean_err.bits == 50000 && clean_err.errors == 0;
+        pipeline_free(pl);
+    }
+    test_true("Tubería sin ruido", pl_clean);
+
+    // Informe: filas de varios hilos unidas en orden de fragmento, y salida CSV/JSON
+    Report *rep_test = report_open("results/report_test.md");
+    report_table_begin(rep_test, "prueba", "Hilo\tValor");
+    pthread_t rep_threads[4];
+    ShardArg rep_args[4];
+    for (unsigned t = 0; t < 4; t++)
+    {
+        rep_args[t] = (ShardArg){rep_test, t};
+        pthread_create(&rep_threads[t], NULL, add_shard_rows, &rep_args[t]);
+    }
+    for (unsigned t = 0; t < 4; t++)
+        pthread_join(rep_threads[t], NULL);
+    size_t rep_rows = report_table_rows(rep_test);
+    int rep_bad = report_row(rep_test, 0, "solo una celda");
+    test_true("Informe con filas concurrentes", rep_rows == 400 && rep_bad == -1 && report_close(rep_test) == 0);
+    FILE *rep_json = fopen("results/report_test.json", "r");
+    char rep_head[64] = {0};
+    if (rep_json)
+    {
+        fread(rep_head, 1, sizeof(rep_head) - 1, rep_json);
+        fclose(rep_json);
+    }
+    test_true("Informe JSON", strstr(rep_head, "\"titulo\": \"prueba\"") != NULL);
+    remove("results/report_test.md");
+    remove("results/report_test.csv");
+    remove("results/report_test.json");
+
+    fclose(signals);
+
     printf("🎉 Todas las pruebas automáticas pasaron correctamente.\n");
 
     // Parte 2: Simulaciones estadísticas con mensaje aleatorio
@@ -94,27 +671,35 @@ int main(void)
         return 1;
     }
 
-    // Crear archivo Markdown para resultados
-    FILE *md = fopen("results/analysis.md", "w");
-    if (!md)
+    // Sesión de informe: un solo archivo abierto para todas las secciones
+    Report *report = report_open("results/analysis.md");
+    if (!report)
     {
-        fprintf(stderr, "No se pudo crear results/analysis.md\n");
         free(bitstream_simulation);
         return 1;
     }
 
-    prepare_analysis_report("results/analysis.md", "30532641", ber);
+    prepare_analysis_report(report, "30532641", ber);
 
     // Simulaciones con ruido
-    run_simulations("results/analysis.md", bitstream_simulation, ber, N, "NRZ", encode_nrz, decode_nrz);
-    run_simulations("results/analysis.md", bitstream_simulation, ber, N, "NRZI", encode_nrzi, decode_nrzi);
-    run_simulations("results/analysis.md", bitstream_simulation, ber, N, "Manchester", encode_manchester, decode_manchester);
-    run_simulations("results/analysis.md", bitstream_4b_simulation, ber, N, "4B/5B", encode_4b5b, decode_4b5b);
-
-    fclose(md);
+    // NRZ, NRZI y Manchester en modo bit-sliced (64 ensayos por palabra)
+    uint64_t seed = (uint64_t)time(NULL);
+    run_simulations_sliced(report, bitstream_simulation, ber, N, "NRZ", seed);
+    run_simulations_sliced(report, bitstream_simulation, ber, N, "NRZI", seed + 1);
+    run_simulations_sliced(report, bitstream_simulation, ber, N, "Manchester", seed + 2);
+    run_simulations(report, bitstream_4b_simulation, ber, N, "4B/5B", encode_4b5b, decode_4b5b);
 
-    run_ber_sensitivity_analysis("results/analysis.md", bitstream_simulation);
+    run_ber_sensitivity_analysis(report, MSG_LEN);
+    run_spectral_analysis(report, (size_t)1 << 20);
+    run_importance_sampling_curve(report, bitstream_4b_simulation, 1000);
+    run_crn_comparison(report, bitstream_4b_simulation, ber, 1000, seed + 3);
+    run_framing_analysis(report, bitstream_4b_simulation, ber, 1000, 96);
+    run_fec_simulations(report, bitstream_simulation, ber, N);
+    run_interleaver_analysis(report, bitstream_simulation, 0.002, 5, N);
+    run_error_distribution(report, bitstream_4b_simulation, ber, 1000, seed + 4);
+    run_pipeline_benchmark(report, (uint64_t)1 << 22, ber, seed + 5);
 
+    report_close(report);
     free(bitstream_simulation);
     free(bitstream_4b_simulation);
 
@@ -0,0 +1,321 @@
+#define _POSIX_C_SOURCE 200809L
+#include "codec.h"
+#include "pipeline.h"
+#include "rng.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file test_scale.c
+ * @brief Prueba de escala: 10^9 bits por esquema con memoria acotada
+ *
+ * Cada esquema del registro recorre la ruta de streaming de la biblioteca
+ * (pipeline_run: fuente → codificador de línea → muestreo → decodificador
+ * → contador de errores). Se verifica:
+ * - ida y vuelta exacta de todos los bits (contador de errores en cero)
+ * - ventanas muestreadas idénticas a una referencia bit a bit escrita aquí,
+ *   que regenera los bits de la fuente con su propio Rng y lleva su propio
+ *   estado de línea de un trozo al siguiente
+ * - pico de memoria residente (VmHWM) por debajo del límite: si la
+ *   biblioteca vuelve a procesar el flujo entero en memoria, la prueba falla
+ *
+ * Uso: test_scale [bits por esquema] [límite de RSS en MB]
+ */
+
+// Bits por trozo (múltiplo de todos los bloques de entrada del registro)
+#define SCALE_CHUNK_BITS (1u << 20)
+
+// Longitud de cada ventana comparada con la referencia (múltiplo de 64)
+#define SCALE_WINDOW_BITS 4096
+
+// Se compara una ventana cada tantos trozos
+#define SCALE_SAMPLE_EVERY 8
+
+#define SCALE_DEFAULT_BITS 1000000000ULL
+#define SCALE_DEFAULT_RSS_MB 64
+
+static void check(const char *name, int condition)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "❌ %s falló.\n", name);
+        exit(1);
+    }
+    printf("✅ %s pasó.\n", name);
+}
+
+/**
+ * Pico de memoria residente en KB (VmHWM), o 0 si no está disponible
+ */
+static size_t peak_rss_kb(void)
+{
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f)
+        return 0;
+
+    char line[256];
+    size_t kb = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        if (strncmp(line, "VmHWM:", 6) == 0)
+        {
+            kb = strtoull(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(f);
+    return kb;
+}
+
+// ============================================
+// Referencia bit a bit
+// ============================================
+
+typedef enum
+{
+    REF_NRZ,
+    REF_NRZI,
+    REF_MANCHESTER,
+    REF_4B5B,
+    REF_AMI,
+    REF_PSEUDOTERNARY,
+    REF_DIFF_MANCHESTER,
+    REF_NONE
+} RefKind;
+
+static const char *const REF_4B5B_TABLE[16] = {"11110", "01001", "10100", "10101", "01010", "01011",
+                                               "01110", "01111", "10010", "10011", "10110", "10111",
+                                               "11010", "11011", "11100", "11101"};
+
+static RefKind ref_kind(const char *name)
+{
+    static const char *const names[] = {"NRZ", "NRZI", "Manchester", "4B/5B", "AMI", "Pseudoternario",
+                                        "Manchester Diferencial"};
+    for (int k = 0; k < REF_NONE; k++)
+        if (strcmp(name, names[k]) == 0)
+            return (RefKind)k;
+    return REF_NONE;
+}
+
+/**
+ * Codifica bits (0/1) desde el estado `level` sin tocarlo.
+ * NRZI y Manchester diferencial: nivel actual (1 = alto);
+ * AMI y pseudoternario: 1 si la próxima marca es '+'.
+ */
+static size_t ref_encode(RefKind kind, int level, const unsigned char *bits, size_t n, char *out)
+{
+    size_t o = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        int b = bits[i];
+        switch (kind)
+        {
+        case REF_NRZ:
+            out[o++] = b ? 'H' : 'L';
+            break;
+        case REF_NRZI:
+            if (b)
+                level = !level;
+            out[o++] = level ? 'H' : 'L';
+            break;
+        case REF_MANCHESTER:
+            out[o++] = b ? '1' : '0';
+            out[o++] = b ? '0' : '1';
+            break;
+        case REF_4B5B:
+            if (i % 4 == 3)
+            {
+                int v = bits[i - 3] << 3 | bits[i - 2] << 2 | bits[i - 1] << 1 | b;
+                memcpy(out + o, REF_4B5B_TABLE[v], 5);
+                o += 5;
+            }
+            break;
+        case REF_AMI:
+        case REF_PSEUDOTERNARY:
+            if (b == (kind == REF_AMI))
+            {
+                out[o++] = level ? '+' : '-';
+                level = !level;
+            }
+            else
+                out[o++] = '0';
+            break;
+        case REF_DIFF_MANCHESTER:
+        {
+            // Un '0' cambia de nivel al inicio del bit; siempre cambia a la mitad
+            int first = b ? level : !level;
+            out[o++] = first ? '1' : '0';
+            out[o++] = first ? '0' : '1';
+            level = !first;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return o;
+}
+
+static int parity64(uint64_t w)
+{
+    w ^= w >> 32;
+    w ^= w >> 16;
+    w ^= w >> 8;
+    w ^= w >> 4;
+    w ^= w >> 2;
+    w ^= w >> 1;
+    return (int)(w & 1);
+}
+
+/**
+ * Estado tras `n` bits cuya paridad de unos es `ones`
+ */
+static int ref_advance(RefKind kind, int level, int ones, size_t n)
+{
+    switch (kind)
+    {
+    case REF_NRZI:
+    case REF_AMI:
+    case REF_DIFF_MANCHESTER:
+        return level ^ ones; // Cada '1' invierte el estado
+    case REF_PSEUDOTERNARY:
+        return level ^ ones ^ (int)(n & 1); // Cada '0' invierte la polaridad
+    default:
+        return level;
+    }
+}
+
+// ============================================
+// Etapa de muestreo
+// ============================================
+
+typedef struct
+{
+    const LineCodec *codec;
+    RefKind kind;
+    Rng rng;           // Mismo flujo que la fuente de la tubería
+    int level;         // Estado de la referencia al inicio del trozo
+    uint64_t index;
+    uint64_t windows;
+    uint64_t mismatches;
+    unsigned char bits[SCALE_WINDOW_BITS];
+    char expected[SCALE_WINDOW_BITS * 2];
+} ScaleTap;
+
+/**
+ * Transformación que deja pasar los símbolos sin tocarlos: regenera los bits
+ * del trozo, compara una ventana cada SCALE_SAMPLE_EVERY trozos y avanza el
+ * estado de la referencia por el trozo completo.
+ */
+static PipeChunk *tap_stage(PipeStage *stage, PipeChunk *in)
+{
+    ScaleTap *tap = stage->ctx;
+    const LineCodec *codec = tap->codec;
+    size_t n_bits = in->len / codec->out_block * codec->in_block;
+    int sample = (tap->index % SCALE_SAMPLE_EVERY == 0);
+    size_t window = (n_bits < SCALE_WINDOW_BITS) ? n_bits : SCALE_WINDOW_BITS;
+    window = window / codec->in_block * codec->in_block;
+
+    // La fuente toma los bits de cada palabra desde el MSB
+    int ones = 0;
+    for (size_t i = 0; i < n_bits; i += 64)
+    {
+        uint64_t w = rng_next(&tap->rng);
+        size_t take = (n_bits - i < 64) ? n_bits - i : 64;
+        if (take < 64)
+            w >>= 64 - take;
+        ones ^= parity64(w);
+        if (sample && i < window)
+            for (size_t k = 0; k < take && i + k < window; k++)
+                tap->bits[i + k] = (unsigned char)((w >> (take - 1 - k)) & 1);
+    }
+
+    if (sample)
+    {
+        size_t n_sym = ref_encode(tap->kind, tap->level, tap->bits, window, tap->expected);
+        if (n_sym > in->len || memcmp(tap->expected, in->data, n_sym) != 0)
+        {
+            fprintf(stderr, "%s: ventana del trozo %llu distinta de la referencia\n", codec->name,
+                    (unsigned long long)tap->index);
+            tap->mismatches++;
+        }
+        tap->windows++;
+    }
+
+    tap->level = ref_advance(tap->kind, tap->level, ones, n_bits);
+    tap->index++;
+    return in;
+}
+
+// ============================================
+// Principal
+// ============================================
+
+int main(int argc, char *argv[])
+{
+    unsigned long long total_bits = (argc > 1) ? strtoull(argv[1], NULL, 10) : SCALE_DEFAULT_BITS;
+    unsigned long long rss_limit_mb = (argc > 2) ? strtoull(argv[2], NULL, 10) : SCALE_DEFAULT_RSS_MB;
+
+    printf("=== Prueba de escala: %llu bits por esquema, límite de RSS %llu MB ===\n", total_bits,
+           rss_limit_mb);
+
+    size_t n_codecs;
+    const LineCodec *codecs = codec_registry(&n_codecs);
+
+    for (size_t c = 0; c < n_codecs; c++)
+    {
+        const LineCodec *codec = &codecs[c];
+        uint64_t bits = total_bits / codec->in_block * codec->in_block;
+        uint64_t seed = 30532641u + c;
+
+        RefKind kind = ref_kind(codec->name);
+        if (kind == REF_NONE)
+        {
+            fprintf(stderr, "%s: no hay referencia bit a bit en test_scale.c\n", codec->name);
+            check(codec->name, 0);
+        }
+
+        ScaleTap *tap = safe_malloc(sizeof(ScaleTap));
+        memset(tap, 0, sizeof(*tap));
+        tap->codec = codec;
+        tap->kind = kind;
+        rng_seed(&tap->rng, seed);
+        tap->level = 1; // Estado inicial acordado: nivel alto / próxima marca '+'
+
+        PipeErrors errors;
+        Pipeline *p = pipeline_create(SCALE_CHUNK_BITS);
+        int ok = p && pipeline_add_source(p, bits, seed) == 0;
+        ok = ok && pipeline_add_line_encoder(p, codec) == 0;
+        ok = ok && pipeline_add_stage(p, "Muestreo", tap_stage, tap, 1, 1) == 0;
+        ok = ok && pipeline_add_line_decoder(p, codec) == 0;
+        ok = ok && pipeline_add_error_counter(p, &errors) == 0;
+
+        clock_t start = clock();
+        ok = ok && pipeline_run(p, 0) == 0;
+        double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        ok = ok && errors.bits == bits && errors.errors == 0 && tap->windows > 0 && tap->mismatches == 0;
+
+        char name[128];
+        snprintf(name, sizeof(name), "%s: %llu trozos, %llu ventanas, %.1f s", codec->name,
+                 (unsigned long long)tap->index, (unsigned long long)tap->windows, secs);
+        // La tubería libera el contexto de la etapa
+        pipeline_free(p);
+        check(name, ok);
+    }
+
+    size_t peak_kb = peak_rss_kb();
+    if (peak_kb == 0)
+    {
+        printf("⚠️  /proc/self/status no disponible: no se verifica el pico de memoria.\n");
+        return 0;
+    }
+
+    char name[128];
+    snprintf(name, sizeof(name), "Pico de RSS %.1f MB <= %llu MB", peak_kb / 1024.0, rss_limit_mb);
+    check(name, peak_kb <= rss_limit_mb * 1024);
+    return 0;
+}
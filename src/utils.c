@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "bitpack.h"
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
@@ -38,13 +39,10 @@ char *string_duplicate(const char *src) {
  */
 int is_valid_bitstream(const char *str) {
     if (str == NULL) return 0;
-    
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (str[i] != '0' && str[i] != '1') {
-            return 0;
-        }
-    }
-    return 1;
+
+    // strlen y la validación vectorizada recorren a varios GB/s
+    size_t len = strlen(str);
+    return bits_validate(str, len, '0', '1') == len;
 }
 
 /**
@@ -58,3 +56,26 @@ void print_binary(uint8_t byte) {
 }
 
 
+
+
+/**
+ * @brief Empaqueta bits ASCII en bytes (primer bit en el MSB)
+ * @param bits Cadena de '0' y '1' (no necesita terminar en '\0')
+ * @param n Número de bits
+ * @param out Buffer de salida de (n + 7) / 8 bytes; el último se rellena con ceros
+ * @return Número de bytes escritos
+ */
+size_t pack_bitstream(const char *bits, size_t n, uint8_t *out) {
+    bits_pack(bits, n, out, '0', '1'); // Cualquier símbolo distinto de '1' cuenta como 0
+    return (n + 7) / 8;
+}
+
+/**
+ * @brief Operación inversa de pack_bitstream
+ * @param in Bytes empaquetados (primer bit en el MSB)
+ * @param n Número de bits
+ * @param out Salida de n caracteres '0'/'1' (sin '\0')
+ */
+void unpack_bitstream(const uint8_t *in, size_t n, char *out) {
+    bits_unpack(in, n, out, '0', '1');
+}
@@ -9,5 +9,7 @@ void *safe_malloc(size_t size);
 char *string_duplicate(const char *src);
 int is_valid_bitstream(const char *str);
 void print_binary(uint8_t byte);
+size_t pack_bitstream(const char *bits, size_t n, uint8_t *out);
+void unpack_bitstream(const uint8_t *in, size_t n, char *out);
 
 #endif
\ No newline at end of file